@@ -0,0 +1,174 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  shared harness for the core benchmarks: timing, allocation counting and reporting.         ///
+///  include it from exactly one translation unit per benchmark program, it replaces the        ///
+///  global `operator new` / `operator delete` to count allocations.                             ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#ifndef __$LIBHELIX_BENCH__
+#define __$LIBHELIX_BENCH__
+
+#include <cstdlib>
+
+#include "../include/core.h"
+
+namespace Bench {
+namespace _state {
+    thread_local inline u64 allocations = 0;
+    thread_local inline u64 bytes       = 0;
+
+    inline i32 report_fd = 1;
+}  // namespace _state
+
+/// \struct Counters
+/// Allocations made by the calling thread so far, subtract two snapshots to get a delta.
+struct Counters {
+    u64 allocations = _state::allocations;
+    u64 bytes       = _state::bytes;
+};
+
+/// \struct Result
+/// Per operation cost of one benchmark case.
+struct Result {
+    double ns          = 0;
+    double allocations = 0;
+    double bytes       = 0;
+};
+
+/// keep `value` (and everything it points to) alive as far as the optimizer can tell.
+template <typename T>
+inline void keep(const T &value) {
+#ifdef _MSC_VER
+    static volatile const void *sink;
+    sink = &value;
+#else
+    __asm__ volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+/// point standard output at `/dev/null` so `print` can be measured without a terminal in the way,
+/// reports keep going to the original standard output.
+inline void silence_stdout() {
+#ifndef _MSC_VER
+    helix::std::flush();
+
+    _state::report_fd = helix::libc::dup(1);
+    const i32 devnull = helix::libc::open("/dev/null", O_WRONLY);
+
+    helix::libc::dup2(devnull, 1);
+    helix::libc::close(devnull);
+
+    helix::std::set_flush_policy(helix::std::Format::FlushPolicy::Size);
+#endif
+}
+
+/// \brief one line per case: name, ns/op, allocations/op and bytes/op.
+inline void report(const char *name, const Result &result) {
+    helix::std::Format::Sink out(_state::report_fd, helix::std::Format::FlushPolicy::Explicit, 256);
+
+    helix::std::Format::format_to(out,
+                                  "\\{:<44\\} \\{:>12.1f\\} ns/op \\{:>8.2f\\} allocs/op \\{:>12.1f\\} B/op\n",
+                                  name,
+                                  result.ns,
+                                  result.allocations,
+                                  result.bytes);
+}
+
+/// \brief time `fn(i)` until the per-operation cost is stable.
+///
+/// the iteration count is doubled until one sample takes at least 20ms, then the fastest of five
+/// samples is kept. allocations are counted on the calling thread only.
+template <typename Fn>
+Result measure(Fn &&fn) {
+    using clock = ::std::chrono::steady_clock;
+
+    auto sample = [&](usize iterations, Result &out) {
+        const Counters before;
+        const auto     start = clock::now();
+
+        for (usize i = 0; i < iterations; ++i) {
+            fn(i);
+        }
+
+        const auto     end = clock::now();
+        const Counters after;
+
+        out.ns          = ::std::chrono::duration<double, ::std::nano>(end - start).count() / double(iterations);
+        out.allocations = double(after.allocations - before.allocations) / double(iterations);
+        out.bytes       = double(after.bytes - before.bytes) / double(iterations);
+    };
+
+    usize  iterations = 1;
+    Result result;
+
+    for (;;) {
+        sample(iterations, result);
+
+        if (result.ns * double(iterations) >= 20e6 || iterations >= (usize(1) << 30)) {
+            break;
+        }
+
+        iterations *= 2;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        Result next;
+        sample(iterations, next);
+
+        if (next.ns < result.ns) {
+            result = next;
+        }
+    }
+
+    return result;
+}
+
+/// measure and report in one step.
+template <typename Fn>
+void run(const char *name, Fn &&fn) {
+    report(name, measure(fn));
+}
+}  // namespace Bench
+
+void *operator new(::std::size_t size) {
+    ++Bench::_state::allocations;
+    Bench::_state::bytes += size;
+
+    if (void *ptr = ::std::malloc(size != 0 ? size : 1)) {
+        return ptr;
+    }
+
+    throw ::std::bad_alloc();
+}
+
+void *operator new[](::std::size_t size) { return ::operator new(size); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // the matching `operator new` uses malloc
+#endif
+
+void operator delete(void *ptr) noexcept { ::std::free(ptr); }
+void operator delete[](void *ptr) noexcept { ::std::free(ptr); }
+void operator delete(void *ptr, ::std::size_t) noexcept { ::std::free(ptr); }
+void operator delete[](void *ptr, ::std::size_t) noexcept { ::std::free(ptr); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
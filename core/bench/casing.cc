@@ -0,0 +1,79 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  case conversion and caseless comparison on 4 MiB of text, ASCII only and with one non-ASCII ///
+///  letter every 16 characters: the vector ASCII kernels against the byte loop, and the table   ///
+///  driven full mappings of `String::Unicode`.                                                  ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace casing  = helix::String::_casing;
+namespace unicode = helix::String::_unicode;
+
+constexpr usize SIZE = usize(4) << 20;
+
+/// mixed case words with one non-ASCII letter every `spacing` characters on average.
+helix::string make_text(u32 spacing) {
+    constexpr char32_t others[] = {0xC9, 0xDF, 0x3A9, 0x3C9, 0x416, 0x1E9E};
+
+    helix::string text;
+    text.reserve(SIZE + 4);
+
+    u32 state = 12345;
+    while (text.size() < SIZE) {
+        state = state * 1103515245 + 12345;
+
+        if ((state >> 8) % spacing == 0) {
+            char bytes[4];
+            text.append(bytes, unicode::write(others[(state >> 16) % 6], bytes));
+        } else if ((state >> 12) % 7 == 0) {
+            text.push_back(' ');
+        } else {
+            text.push_back(static_cast<char>(((state >> 20) & 1 ? 'a' : 'A') + (state >> 16) % 26));
+        }
+    }
+
+    return text;
+}
+
+void suite(const char *name, const helix::string &text) {
+    const auto                 upper = helix::String::Unicode::upper(text);
+    helix::list<char>          out(text.size());
+    helix::String::slice<char> view(text.data(), text.size());
+    helix::String::slice<char> other(upper.data(), upper.size());
+
+    Bench::run(helix::std::stringf("\\{:<6\\} scalar ascii lower", name).c_str(), [&](usize) {
+        Bench::keep(casing::scalar::ascii_case(text.data(), text.size(), out.data(), 'A'));
+    });
+    Bench::run(helix::std::stringf("\\{:<6\\} ascii lower", name).c_str(), [&](usize) {
+        Bench::keep(casing::ascii_case(text.data(), text.size(), out.data(), 'A'));
+    });
+    Bench::run(helix::std::stringf("\\{:<6\\} lower", name).c_str(), [&](usize) { Bench::keep(helix::String::Unicode::lower(view).size()); });
+    Bench::run(helix::std::stringf("\\{:<6\\} upper", name).c_str(), [&](usize) { Bench::keep(helix::String::Unicode::upper(view).size()); });
+    Bench::run(helix::std::stringf("\\{:<6\\} title", name).c_str(), [&](usize) { Bench::keep(helix::String::Unicode::title(view).size()); });
+    Bench::run(helix::std::stringf("\\{:<6\\} casefold", name).c_str(), [&](usize) { Bench::keep(helix::String::Unicode::casefold(view).size()); });
+    Bench::run(helix::std::stringf("\\{:<6\\} equal_fold", name).c_str(), [&](usize) { Bench::keep(helix::String::Unicode::equal_fold(view, other)); });
+}
+}  // namespace
+
+int main() {
+    suite("ascii", make_text(1U << 30));
+    suite("1/16", make_text(16));
+
+    return 0;
+}
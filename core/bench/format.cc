@@ -0,0 +1,133 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  cost of the formatting and printing layer every helix program goes through: `to_string`,  ///
+///  `stringf`, `mapped_format`, `print` and the container formatters, at several sizes.        ///
+///  `print` and `stream` are measured against `/dev/null`.                                     ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace hx = helix::std;
+
+helix::list<i32> make_list(usize size) {
+    helix::list<i32> list;
+    list.reserve(size);
+
+    for (usize i = 0; i < size; ++i) {
+        list.push_back(static_cast<i32>(i * 7919 % 100003));
+    }
+
+    return list;
+}
+
+helix::map<i32, helix::string> make_map(usize size) {
+    helix::map<i32, helix::string> map;
+
+    for (usize i = 0; i < size; ++i) {
+        map.emplace(static_cast<i32>(i), "value-" + ::std::to_string(i));
+    }
+
+    return map;
+}
+
+void numbers() {
+    Bench::run("to_string      i32 (3 digits)", [](usize i) { Bench::keep(hx::to_string(static_cast<i32>(i % 1000))); });
+    Bench::run("to_string      i64 (19 digits)", [](usize i) { Bench::keep(hx::to_string(INT64_MAX - static_cast<i64>(i))); });
+    Bench::run("to_string      f64", [](usize i) { Bench::keep(hx::to_string(double(i) * 0.1)); });
+    Bench::run("to_string      bool", [](usize i) { Bench::keep(hx::to_string((i & 1) != 0)); });
+
+    Bench::run("to_string_into i64", [](usize i) {
+        char buffer[32];
+        Bench::keep(hx::to_string_into(buffer, INT64_MAX - static_cast<i64>(i)));
+        Bench::keep(buffer);
+    });
+}
+
+void strings() {
+    for (const usize size : {16, 256, 65536}) {
+        const helix::string text(size, 'x');
+        const auto          name = hx::stringf("to_string      string (\\{\\} B)", size);
+
+        Bench::run(name.c_str(), [&](usize) { Bench::keep(hx::to_string(text)); });
+    }
+}
+
+void formatting() {
+    const helix::string user = "some-user@example.org";
+
+    Bench::run("stringf        one int", [](usize i) { Bench::keep(hx::stringf("value \\{\\}", i)); });
+    Bench::run("stringf        int, f64, string", [&](usize i) {
+        Bench::keep(hx::stringf("req \\{\\} took \\{\\}ms for \\{\\}", i, 1.25, user));
+    });
+    Bench::run("stringf        specifiers", [&](usize i) {
+        Bench::keep(hx::stringf("\\{:>24\\} | \\{:#010x\\} | \\{:.3f\\}", user, i, double(i) / 3));
+    });
+    Bench::run("mapped_format  int, f64, string", [&](usize i) {
+        Bench::keep(hx::mapped_format<"req {id} took {ms}ms for {user}">(
+            hx::Format::arg<"id">(i), hx::Format::arg<"ms">(1.25), hx::Format::arg<"user">(user)));
+    });
+
+    const hx::Format::Template tpl("req {id} took {ms}ms for {user}", {"id", "ms", "user"});
+    Bench::run("Template       int, f64, string", [&](usize i) { Bench::keep(tpl.format(i, 1.25, user)); });
+}
+
+void containers() {
+    for (const usize size : {10, 1000, 100000}) {
+        const auto list = make_list(size);
+        const auto name = hx::stringf("to_string      list<i32> (\\{\\})", size);
+
+        Bench::run(name.c_str(), [&](usize) { Bench::keep(hx::to_string(list)); });
+    }
+
+    for (const usize size : {10, 1000}) {
+        const auto map  = make_map(size);
+        const auto name = hx::stringf("to_string      map<i32, string> (\\{\\})", size);
+
+        Bench::run(name.c_str(), [&](usize) { Bench::keep(hx::to_string(map)); });
+    }
+
+    const helix::list<helix::list<i32>> nested(100, make_list(100));
+    Bench::run("to_string      list<list<i32>> (100 x 100)", [&](usize) { Bench::keep(hx::to_string(nested)); });
+}
+
+void printing() {
+    const auto list = make_list(1000);
+
+    Bench::run("print          one int", [](usize i) { helix::print(i); });
+    Bench::run("print          int, f64, string", [](usize i) { helix::print("req ", i, " took ", 1.25, "ms"); });
+    Bench::run("print          list<i32> (1000)", [&](usize) { helix::print(list); });
+
+    const auto big = make_list(100000);
+    Bench::run("stream         list<i32> (100000)", [&](usize) { hx::stream(big); });
+    Bench::run("stream         list<i32> (100000), 100 max", [&](usize) { hx::stream(big, {.max_elements = 100}); });
+
+    hx::flush();
+}
+}  // namespace
+
+int main() {
+    Bench::silence_stdout();
+
+    numbers();
+    strings();
+    formatting();
+    containers();
+    printing();
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  producer side cost of `Log::*` against formatting the same line on the calling thread.     ///
+///  records are logged in bursts that fit in the ring, only the logging calls are timed; the   ///
+///  consumer drains between bursts so the producer never waits on it.                          ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace hx = helix::std;
+
+using clock_t_ = ::std::chrono::steady_clock;
+
+constexpr usize BURST  = 1024;
+constexpr usize ROUNDS = 512;
+
+/// the harness's `Bench::measure` cannot be used here, the consumer has to drain between bursts
+/// outside the timed region.
+template <typename Fn>
+Bench::Result time_bursts(Fn &&fn) {
+    double                total = 0;
+    const Bench::Counters before;
+
+    for (usize round = 0; round < ROUNDS; ++round) {
+        const auto start = clock_t_::now();
+
+        for (usize i = 0; i < BURST; ++i) {
+            fn(i);
+        }
+
+        total += ::std::chrono::duration<double, ::std::nano>(clock_t_::now() - start).count();
+        hx::Log::flush();
+    }
+
+    const Bench::Counters after;
+    const double          ops = double(BURST * ROUNDS);
+
+    return {total / ops, double(after.allocations - before.allocations) / ops, double(after.bytes - before.bytes) / ops};
+}
+}  // namespace
+
+int main() {
+    const i32 devnull = helix::libc::open("/dev/null", O_WRONLY);
+    hx::Log::set_output(devnull);
+
+    const ::std::string user = "some-user@example.org";
+
+    hx::Log::info<"warmup">();
+    hx::Log::flush();
+
+    Bench::report("log            int", time_bursts([](usize i) { hx::Log::info<"value \\{\\}">(i); }));
+    Bench::report("log            int, f64, literal", time_bursts([](usize i) { hx::Log::info<"req \\{\\} took \\{\\}ms \\{\\}">(i, 1.25, "ok"); }));
+    Bench::report("log            int, string", time_bursts([&](usize i) { hx::Log::info<"user \\{\\} id \\{\\}">(user, i); }));
+    Bench::report("stringf        int, f64, literal", time_bursts([](usize i) { auto s = hx::stringf("req \\{\\} took \\{\\}ms \\{\\}", i, 1.25, "ok"); (void)s; }));
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  grapheme cluster counting, display width and boundary lookups on 4 MiB of text, ASCII only  ///
+///  (also split into LF and CRLF lines) and with a CJK character, emoji sequence or combining   ///
+///  mark every 16 characters: the vector ASCII path against walking every cluster through the   ///
+///  tables, with `memcpy` for scale.                                                            ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace segment = helix::String::_segment;
+namespace unicode = helix::String::Unicode;
+
+constexpr usize SIZE = usize(4) << 20;
+
+/// words with one non-ASCII cluster every `spacing` characters on average, and `eol` (when
+/// given) ending a line about every 60 characters.
+helix::string make_text(u32 spacing, const char *eol = nullptr) {
+    constexpr const char *others[] = {"\xE6\xBC\xA2", "e\xCC\x81", "\xF0\x9F\x91\x8D\xF0\x9F\x8F\xBD",
+                                      "\xF0\x9F\x87\xBA\xF0\x9F\x87\xB8", "\xED\x95\x9C", "\xC3\xA9"};
+
+    helix::string text;
+    text.reserve(SIZE + 16);
+
+    u32 state = 12345;
+    while (text.size() < SIZE) {
+        state = state * 1103515245 + 12345;
+
+        if ((state >> 8) % spacing == 0) {
+            text.append(others[(state >> 16) % 6]);
+        } else if (eol != nullptr && (state >> 4) % 60 == 0) {
+            text.append(eol);
+        } else if ((state >> 12) % 7 == 0) {
+            text.push_back(' ');
+        } else {
+            text.push_back(static_cast<char>('a' + (state >> 16) % 26));
+        }
+    }
+
+    return text;
+}
+
+void suite(const char *name, const helix::string &text) {
+    helix::String::slice<char> view(text.data(), text.size());
+    helix::list<char>          out(text.size());
+
+    Bench::run(helix::std::stringf("\\{:<6\\} memcpy", name).c_str(), [&](usize) {
+        std::memcpy(out.data(), text.data(), text.size());
+        Bench::keep(out[text.size() / 2]);
+    });
+    Bench::run(helix::std::stringf("\\{:<6\\} cluster walk", name).c_str(), [&](usize) {
+        const char *first = text.data();
+        const char *last  = first + text.size();
+        usize       total = 0;
+
+        for (usize columns = 0; first != last; total += columns) {
+            first = segment::cluster(first, last, columns);
+        }
+
+        Bench::keep(total);
+    });
+    Bench::run(helix::std::stringf("\\{:<6\\} grapheme_count", name).c_str(), [&](usize) { Bench::keep(unicode::grapheme_count(view)); });
+    Bench::run(helix::std::stringf("\\{:<6\\} width", name).c_str(), [&](usize) { Bench::keep(unicode::width(view)); });
+    Bench::run(helix::std::stringf("\\{:<6\\} floor_grapheme x4096", name).c_str(), [&](usize) {
+        usize total = 0;
+
+        for (usize pos = 0; pos < text.size(); pos += text.size() / 4096) {
+            total += unicode::floor_grapheme(view, pos);
+        }
+
+        Bench::keep(total);
+    });
+}
+
+/// `Unicode::center_align` with a fill of several bytes, which must pad with whole copies of it;
+/// the result is checked once before it is timed.
+void align_suite() {
+    const helix::String::slice<char> cell("\xE6\xBC\xA2\xE5\xAD\x97", 6);  // two wide characters
+    const helix::String::slice<char> rule("\xE2\x94\x80", 3);              // a box drawing line
+
+    const auto padded = unicode::center_align(cell, 9, rule);
+    if (padded.size() != cell.size() + 5 * rule.size() || unicode::width(padded.as_slice()) != 9 ||
+        !unicode::valid(padded.as_slice())) {
+        std::abort();
+    }
+
+    Bench::run("align  center_align 80 columns", [&](usize) { Bench::keep(unicode::center_align(cell, 80, rule).size()); });
+}
+}  // namespace
+
+int main() {
+    suite("ascii", make_text(1U << 30));
+    suite("lf", make_text(1U << 30, "\n"));
+    suite("crlf", make_text(1U << 30, "\r\n"));
+    suite("1/16", make_text(16));
+    align_suite();
+
+    return 0;
+}
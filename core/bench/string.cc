@@ -0,0 +1,289 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  string search on an 8 MiB text: the vector kernels behind `slice::find`, `count` and       ///
+///  `basic::find_replace` against the naive loops they replace, and each kernel set against    ///
+///  the others.                                                                                 ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace hx = helix::std;
+namespace search = helix::String::_search;
+
+using slice = helix::String::slice<char>;
+using basic = helix::String::basic<char>;
+
+constexpr usize SIZE = usize(8) << 20;
+
+/// lowercase words separated by spaces with a newline every ~80 characters; `needle` appears
+/// once, at the very end.
+helix::string make_text(const char *needle) {
+    helix::string text;
+    text.reserve(SIZE);
+
+    u32 state = 12345;
+    while (text.size() < SIZE - 64) {
+        state = state * 1103515245 + 12345;
+        text.push_back(static_cast<char>('a' + (state >> 16) % 26));
+
+        if ((state >> 8) % 7 == 0) {
+            text.push_back((state >> 4) % 12 == 0 ? '\n' : ' ');
+        }
+    }
+
+    text += needle;
+    return text;
+}
+
+usize naive_find(const char *first, usize size, const char *needle, usize length) {
+    for (usize i = 0; i + length <= size; ++i) {
+        usize j = 0;
+        while (j < length && first[i + j] == needle[j]) {
+            ++j;
+        }
+
+        if (j == length) {
+            return i;
+        }
+    }
+
+    return size;
+}
+
+usize naive_count(const char *first, usize size, char chr) {
+    usize count = 0;
+
+    for (usize i = 0; i < size; ++i) {
+        if (first[i] == chr) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+helix::string naive_replace(const helix::string &text, const helix::string &from, const helix::string &to) {
+    helix::string result;
+
+    for (usize i = 0; i < text.size();) {
+        if (text.compare(i, from.size(), from) == 0) {
+            result += to;
+            i += from.size();
+        } else {
+            result.push_back(text[i++]);
+        }
+    }
+
+    return result;
+}
+
+/// what splitting without views costs: a new string per piece.
+usize naive_split(const helix::string &text, char delimiter) {
+    helix::list<helix::string>   pieces;
+    usize                        start = 0;
+
+    for (usize i = 0; i <= text.size(); ++i) {
+        if (i == text.size() || text[i] == delimiter) {
+            pieces.emplace_back(text, start, i - start);
+            start = i + 1;
+        }
+    }
+
+    return pieces.size();
+}
+
+/// sums the piece sizes so the pieces are looked at.
+template <typename Splitter>
+usize walk(Splitter pieces) {
+    usize total = 0;
+
+    for (const slice &piece : pieces) {
+        total += piece.size();
+    }
+
+    return total;
+}
+
+/// `mul` as written in `pkgs/std/string.hlx` before it planned its capacity.
+basic naive_repeat(const basic &text, usize count) {
+    basic result;
+
+    for (usize i = 0; i < count; ++i) {
+        result += text;
+    }
+
+    return result;
+}
+
+/// `prefix + id + ":" + suffix` one `+` at a time, each making a new string (how `+` used to
+/// work).
+basic eager_key(const basic &prefix, const basic &id, const basic &suffix) {
+    basic key = prefix;
+    key.append(id.data(), id.size());
+    basic with_colon = key;
+    with_colon.append(":", 1);
+    basic result = with_colon;
+    result.append(suffix.data(), suffix.size());
+
+    return result;
+}
+
+/// a pipeline stage that takes its string by value.
+template <typename Text>
+[[gnu::noinline]] usize stage(Text text) {
+    return text.size();
+}
+
+void kernels(const char *name, const search::Kernels &set, const helix::string &text) {
+    const char *first = text.data();
+    const char *last  = first + text.size();
+
+    Bench::run(hx::stringf("\\{:<8\\} find byte", name).c_str(), [&](usize) { Bench::keep(set.find_byte(first, last, '#')); });
+    Bench::run(hx::stringf("\\{:<8\\} count byte", name).c_str(), [&](usize) { Bench::keep(set.count_byte(first, last, '\n')); });
+    Bench::run(hx::stringf("\\{:<8\\} find \"needle#\"", name).c_str(), [&](usize) { Bench::keep(set.find(first, last, "needle#", 7)); });
+}
+}  // namespace
+
+int main() {
+    const helix::string text = make_text("needle#");
+    const slice         view(text.data(), text.size());
+    const basic         owned(text.data(), text.size());
+
+    Bench::run("naive    find \"needle#\"", [&](usize) { Bench::keep(naive_find(text.data(), text.size(), "needle#", 7)); });
+    Bench::run("naive    count byte", [&](usize) { Bench::keep(naive_count(text.data(), text.size(), '\n')); });
+    Bench::run("naive    split ' '", [&](usize) { Bench::keep(naive_split(text, ' ')); });
+    Bench::run("naive    replace \" the \" -> \" a \"", [&](usize) { Bench::keep(naive_replace(text, " the ", " a ")); });
+
+    kernels("scalar", {search::scalar::find_byte, search::scalar::count_byte, search::scalar::find, search::scalar::match_any}, text);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    kernels("sse2", {search::sse2::find_byte, search::sse2::count_byte, search::sse2::find, search::sse2::match_any}, text);
+
+    if (__builtin_cpu_supports("avx2")) {
+        kernels("avx2", {search::avx2::find_byte, search::avx2::count_byte, search::avx2::find, search::avx2::match_any}, text);
+    }
+#endif
+
+    Bench::run("slice    find \"needle#\"", [&](usize) { Bench::keep(view.find(slice("needle#", 7))); });
+    Bench::run("slice    count \" the \"", [&](usize) { Bench::keep(view.count(slice(" the ", 5))); });
+    Bench::run("basic    find_replace \" the \" -> \" a \"", [&](usize) {
+        Bench::keep(owned.find_replace(slice(" the ", 5), slice(" a ", 3)));
+    });
+    Bench::run("split    ' '", [&](usize) { Bench::keep(walk(helix::String::split(view, ' '))); });
+    Bench::run("split    any of \" \\n\"", [&](usize) { Bench::keep(walk(helix::String::split_any(view, " \n"))); });
+    Bench::run("split    \" the \"", [&](usize) { Bench::keep(walk(helix::String::split(view, " the "))); });
+    Bench::run("split    isspace", [&](usize) { Bench::keep(walk(helix::String::split(view, [](char chr) { return chr == ' ' || chr == '\n'; }))); });
+
+    const helix::String::shared<char>                                 shared(view.split(0, 4096));
+    const helix::String::shared<char, helix::String::Sharing::Local> local(view.split(0, 4096));
+    const basic                                                       copied(text.data(), 4096);
+
+    Bench::run("basic    copy 4 KiB by value", [&](usize) { Bench::keep(stage(copied)); });
+    Bench::run("shared   copy 4 KiB by value", [&](usize) { Bench::keep(stage(shared)); });
+    Bench::run("shared   copy 4 KiB by value, local", [&](usize) { Bench::keep(stage(local)); });
+    Bench::run("shared   substr", [&](usize) { Bench::keep(stage(shared.substr(100, 1000))); });
+
+    const basic                cell("0123456789abcdef");
+    helix::list<helix::string> words;
+    for (const slice &word : helix::String::split(view.split(0, 1 << 16), ' ')) {
+        words.emplace_back(word.data(), word.size());
+    }
+
+    Bench::run("naive    repeat 16 B x 4096", [&](usize) { Bench::keep(naive_repeat(cell, 4096).size()); });
+    Bench::run("builder  repeat 16 B x 4096", [&](usize) { Bench::keep((cell * 4096).size()); });
+    Bench::run("builder  join words", [&](usize) { Bench::keep(helix::String::join(slice(", ", 2), words).size()); });
+    Bench::run("builder  center_align 4 KiB", [&](usize) { Bench::keep(helix::String::center_align(cell.as_slice(), 4096, slice("-=", 2)).size()); });
+
+    const basic prefix("tenant/eu-west-1/users/");
+    const basic id("0000012345");
+    const basic suffix("profile/settings");
+
+    Bench::run("eager    prefix + id + \":\" + suffix", [&](usize) { Bench::keep(eager_key(prefix, id, suffix).size()); });
+    Bench::run("concat   prefix + id + \":\" + suffix", [&](usize) {
+        const basic key = prefix + id + ":" + suffix;
+        Bench::keep(key.size());
+    });
+
+    Bench::run("heap     64 strings per request", [&](usize) {
+        usize total = 0;
+
+        for (usize i = 0; i < 64; ++i) {
+            basic line(prefix.data(), prefix.size());
+            line.append(suffix.data(), suffix.size());
+            line.append(id.data(), id.size());
+            total += line.size();
+        }
+
+        Bench::keep(total);
+    });
+
+    const std::string line(4096, 'l');
+    Bench::run("std::string -> basic  copy    4 KiB", [&](usize) {
+        std::string text = line;
+        basic       copy(text.data(), text.size());
+        Bench::keep(copy.size());
+    });
+
+    Bench::run("std::string -> basic  move    4 KiB", [&](usize) {
+        std::string text = line;
+        basic       moved(std::move(text));
+        Bench::keep(moved.size());
+    });
+
+    helix::std::Memory::Arena arena;
+    Bench::run("arena    64 strings per request", [&](usize) {
+        using arena_string = helix::String::basic<char, 16, helix::std::Memory::ArenaAllocator>;
+        usize total        = 0;
+
+        for (usize i = 0; i < 64; ++i) {
+            arena_string line(prefix.data(), prefix.size(), arena);
+            line.append(suffix.data(), suffix.size());
+            line.append(id.data(), id.size());
+            total += line.size();
+        }
+
+        arena.reset();
+        Bench::keep(total);
+    });
+
+    // a string grown a character at a time extends its block in place (`realloc`), the arena
+    // must not fill up with the buffers it outgrew; checked once before timing.
+    helix::std::Memory::Arena scratch(1 << 20);
+
+    const auto grow = [&] {
+        using arena_string = helix::String::basic<char, 16, helix::std::Memory::ArenaAllocator>;
+
+        arena_string text(scratch);
+        for (usize i = 0; i < 64 * 1024; ++i) {
+            text.push_back(static_cast<char>('a' + i % 26));
+        }
+
+        return text.size();
+    };
+
+    if (grow() != 64 * 1024 || scratch.used() > 64 * 1024 + 64) {
+        std::abort();
+    }
+    scratch.reset();
+
+    Bench::run("arena    grow one string to 64 KiB", [&](usize) {
+        Bench::keep(grow());
+        scratch.reset();
+    });
+
+    return 0;
+}
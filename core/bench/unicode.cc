@@ -0,0 +1,88 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+///                                                                                              ///
+///  unicode validation and transcoding on 16 MiB of mixed text (mostly ASCII with two, three    ///
+///  and four byte sequences sprinkled in): the vector kernels behind `String::Unicode` against  ///
+///  the scalar code point loop they fall back to.                                               ///
+///                                                                                              ///
+///----------------------------------------------------------------------------------------------///
+
+#include "bench.hh"
+
+namespace {
+namespace unicode = helix::String::_unicode;
+
+constexpr usize SIZE = usize(16) << 20;
+
+/// words of ASCII with one non-ASCII code point every `spacing` characters on average.
+helix::string make_text(u32 spacing) {
+    constexpr char32_t others[] = {0xE9, 0x3B1, 0x4E2D, 0x20AC, 0x1F600};
+
+    helix::string text;
+    text.reserve(SIZE + 4);
+
+    u32 state = 12345;
+    while (text.size() < SIZE) {
+        state = state * 1103515245 + 12345;
+
+        if ((state >> 8) % spacing == 0) {
+            char bytes[4];
+            text.append(bytes, unicode::write(others[(state >> 16) % 5], bytes));
+        } else {
+            text.push_back((state >> 12) % 7 == 0 ? ' ' : static_cast<char>('a' + (state >> 16) % 26));
+        }
+    }
+
+    return text;
+}
+
+void suite(const char *name, const helix::string &text) {
+    const char *first = text.data();
+    const char *last  = first + text.size();
+
+    const usize         units = unicode::length<char32_t>(first, last);
+    helix::list<char32_t> wide(units);
+    helix::list<char>     narrow(text.size());
+
+    unicode::convert(first, last, wide.data());
+
+    const char32_t *wide_first = wide.data();
+    const char32_t *wide_last  = wide_first + units;
+
+    Bench::run(helix::std::stringf("\\{:<7\\} scalar validate utf-8", name).c_str(), [&](usize) { Bench::keep(unicode::scalar::validate(first, last).read); });
+    Bench::run(helix::std::stringf("\\{:<7\\} validate utf-8", name).c_str(), [&](usize) { Bench::keep(unicode::validate(first, last).read); });
+    Bench::run(helix::std::stringf("\\{:<7\\} length utf-8 -> utf-32", name).c_str(), [&](usize) { Bench::keep(unicode::length<char32_t>(first, last)); });
+    Bench::run(helix::std::stringf("\\{:<7\\} scalar utf-8 -> utf-32", name).c_str(), [&](usize) {
+        Bench::keep(unicode::scalar::convert(first, last, wide.data()).written);
+    });
+    Bench::run(helix::std::stringf("\\{:<7\\} convert utf-8 -> utf-32", name).c_str(), [&](usize) {
+        Bench::keep(unicode::convert(first, last, wide.data()).written);
+    });
+    Bench::run(helix::std::stringf("\\{:<7\\} transcode utf-8 -> utf-32", name).c_str(), [&](usize) {
+        Bench::keep(helix::String::Unicode::transcode<char32_t>(text).size());
+    });
+    Bench::run(helix::std::stringf("\\{:<7\\} convert utf-32 -> utf-8", name).c_str(), [&](usize) {
+        Bench::keep(unicode::convert(wide_first, wide_last, narrow.data()).written);
+    });
+}
+}  // namespace
+
+int main() {
+    suite("ascii", make_text(1U << 30));
+    suite("1/64", make_text(64));
+    suite("1/4", make_text(4));
+
+    return 0;
+}
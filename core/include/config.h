@@ -55,4 +55,11 @@ namespace libcxx = ::std;
 #define LIBCXX_NAMESPACE libcxx
 #define LIBC_NAMESPACE libc
 
+/// x86 vector kernels are compiled per function with `H_TARGET("avx2")` and chosen at runtime,
+/// so the translation unit itself never needs `-mavx2`.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define H_SIMD_X86 1
+#define H_TARGET(isa) __attribute__((target(isa)))
+#endif
+
 #endif
\ No newline at end of file
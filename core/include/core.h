@@ -31,6 +31,7 @@
 #include "libc.h"
 #include "interfaces.h"
 #include "config.h"
+#include "demangle.h"
 #include "lang/cast.hh"
 #include "lang/finally.hh"
 #include "lang/function.hh"
@@ -40,6 +41,17 @@
 #include "libcxx.h"
 #include "primitives.h"
 #include "print.h"
+#include "types/string.hh"
+#include "types/string/rope.hh"
+#include "types/string/atom.hh"
+#include "types/string/unicode.hh"
+#include "types/string/compact.hh"
+#include "types/string/casing.hh"
+#include "types/string/split.hh"
+#include "types/string/shared.hh"
+#include "types/string/builder.hh"
+#include "types/string/segment.hh"
+#include "log.h"
 #include "meta.h"
 #include "undef.h"
 
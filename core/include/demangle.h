@@ -0,0 +1,189 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_DEMANGLE__
+#define __$LIBHELIX_DEMANGLE__
+
+#include "config.h"
+#include "libc.h"
+#include "libcxx.h"
+#include "primitives.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace _demangle {
+/// \class Arena
+/// Append-only storage for demangled names. Blocks are never freed, a name handed out stays
+/// valid for the rest of the process.
+class Arena {
+  public:
+    static constexpr usize block_size = 4096;
+
+    const char *store(const char *str, usize size) {
+        if (size > block_size / 4) {  // long names get a block of their own
+            auto *block = static_cast<char *>(::operator new(size));
+            LIBCXX_NAMESPACE::memcpy(block, str, size);
+            return block;
+        }
+
+        if (m_left < size) {
+            m_next = static_cast<char *>(::operator new(block_size));
+            m_left = block_size;
+        }
+
+        char *dest = m_next;
+        LIBCXX_NAMESPACE::memcpy(dest, str, size);
+
+        m_next += size;
+        m_left -= size;
+
+        return dest;
+    }
+
+  private:
+    char *m_next = nullptr;
+    usize m_left = 0;
+};
+
+/// \class Cache
+///
+/// Maps `type_info` addresses to demangled names.
+///
+/// ### Design Details
+/// - **Lock-free reads**: lookups probe a fixed open-addressed table; a slot's name is written
+///   before its key is published with release ordering, so a reader that sees the key sees the
+///   name.
+/// - **Locked inserts**: a miss takes the mutex, re-probes, demangles and publishes. Each type is
+///   demangled at most once per `type_info` object.
+/// - **Overflow**: once the table is full, further types go to a map behind the same mutex.
+/// - **Lifetime**: the cache is intentionally leaked so names stay valid during static
+///   destruction (panics at exit still print their type).
+class Cache {
+  public:
+    static Cache &instance() {
+        static Cache *cache = new Cache();  // NOLINT: leaked on purpose, see above
+        return *cache;
+    }
+
+    LIBCXX_NAMESPACE::string_view get(const LIBCXX_NAMESPACE::type_info &info) {
+        const usize start = hash(&info);
+
+        for (usize i = 0; i < slots; ++i) {
+            const Slot                        &slot = m_slots[(start + i) & (slots - 1)];
+            const LIBCXX_NAMESPACE::type_info *key  = slot.key.load(LIBCXX_NAMESPACE::memory_order_acquire);
+
+            if (key == &info) {
+                return {slot.name, slot.size};
+            }
+
+            if (key == nullptr) {
+                break;
+            }
+        }
+
+        return insert(info);
+    }
+
+  private:
+    static constexpr usize slots = 1024;
+
+    struct Slot {
+        LIBCXX_NAMESPACE::atomic<const LIBCXX_NAMESPACE::type_info *> key{nullptr};
+        const char                                                   *name = nullptr;
+        usize                                                         size = 0;
+    };
+
+    Cache() = default;
+
+    static usize hash(const void *ptr) noexcept {
+        auto bits = reinterpret_cast<LIBCXX_NAMESPACE::uintptr_t>(ptr);
+        bits      = (bits >> 4) * 0x9E3779B97F4A7C15ULL;
+
+        return static_cast<usize>(bits >> 32);
+    }
+
+    LIBCXX_NAMESPACE::string_view demangle(const LIBCXX_NAMESPACE::type_info &info) {
+        const char *mangled = info.name();
+
+#ifdef _MSC_VER
+        return mangled;  // msvc names are already readable and live in static storage
+#else
+        int   status    = 0;
+        char *demangled = libc::abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+
+        if (status != 0 || demangled == nullptr) {
+            return mangled;
+        }
+
+        const usize size = LIBCXX_NAMESPACE::strlen(demangled);
+        const char *name = m_arena.store(demangled, size);
+        free(demangled);
+
+        return {name, size};
+#endif
+    }
+
+    LIBCXX_NAMESPACE::string_view insert(const LIBCXX_NAMESPACE::type_info &info) {
+        LIBCXX_NAMESPACE::lock_guard<LIBCXX_NAMESPACE::mutex> guard(m_lock);
+
+        const usize start = hash(&info);
+
+        for (usize i = 0; i < slots; ++i) {
+            Slot                              &slot = m_slots[(start + i) & (slots - 1)];
+            const LIBCXX_NAMESPACE::type_info *key  = slot.key.load(LIBCXX_NAMESPACE::memory_order_relaxed);
+
+            if (key == &info) {
+                return {slot.name, slot.size};
+            }
+
+            if (key == nullptr) {
+                const LIBCXX_NAMESPACE::string_view name = demangle(info);
+
+                slot.name = name.data();
+                slot.size = name.size();
+                slot.key.store(&info, LIBCXX_NAMESPACE::memory_order_release);
+
+                return name;
+            }
+        }
+
+        auto found = m_overflow.find(&info);
+        if (found != m_overflow.end()) {
+            return found->second;
+        }
+
+        return m_overflow.emplace(&info, demangle(info)).first->second;
+    }
+
+    Slot                                                                           m_slots[slots];
+    LIBCXX_NAMESPACE::mutex                                                        m_lock;
+    Arena                                                                          m_arena;
+    LIBCXX_NAMESPACE::map<const LIBCXX_NAMESPACE::type_info *, LIBCXX_NAMESPACE::string_view> m_overflow;
+};
+}  // namespace _demangle
+
+/// \include belongs to the helix standard library.
+/// \brief the human readable name of a type
+///
+/// the name is demangled the first time a `type_info` is seen and cached for the rest of the
+/// process, later calls are a lock-free table lookup. the returned view never dangles.
+inline LIBCXX_NAMESPACE::string_view demangle(const LIBCXX_NAMESPACE::type_info &info) {
+    return _demangle::Cache::instance().get(info);
+}
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
@@ -40,8 +40,24 @@ concept Castable = requires(T t, U *u) {
     { t.operator U() } -> H_STD_NAMESPACE::Meta::same_as<U>; // call the implicit cast
 };
 
+/// \concept Formattable
+///
+/// A type that writes its own textual form into a caller supplied output, instead of returning
+/// a `string`. `to_string`, `print` and `stringf` prefer it over every other conversion for
+/// class types, so nested values are appended into one buffer rather than built as temporaries.
+///
+/// either form is accepted:
+/// - `void operator$format(Format::Buffer &out) const`
+/// - `Format::Appender operator$format(Format::Appender out) const` (an output iterator)
 template <typename T>
-concept ConvertibleToString = SupportsOStream<T> || Castable<T, string>;
+concept Formattable = requires(const T &t, Format::Buffer &out) {
+    t.operator$format(out);
+} || requires(const T &t, Format::Appender out) {
+    t.operator$format(out);
+};
+
+template <typename T>
+concept ConvertibleToString = SupportsOStream<T> || Castable<T, string> || Formattable<T>;
 }  // namespace Interfaces
 H_STD_NAMESPACE_END
 H_NAMESPACE_END
@@ -22,6 +22,7 @@
 #define __$LIBHELIX_PANIC__
 
 #include "../config.h"
+#include "../demangle.h"
 #include "../lang/function.hh"
 #include "../libc.h"
 #include "../memory.h"
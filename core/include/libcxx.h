@@ -18,16 +18,28 @@
 
 #include <any>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <algorithm>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <coroutine>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <limits>
 #include <map>
+#include <mutex>
+#include <new>
 #include <optional>
 #include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
@@ -0,0 +1,537 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_LOG__
+#define __$LIBHELIX_LOG__
+
+#include "config.h"
+#include "libcxx.h"
+#include "memory.h"
+#include "meta.h"
+#include "primitives.h"
+#include "print.h"
+#include "print/buffer.h"
+#include "print/format.h"
+#include "print/sink.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// \namespace Log
+///
+/// A logger that keeps formatting off the calling thread.
+///
+/// ### Overview
+/// A log call copies its raw argument values and a pointer identifying the call site into a
+/// lock-free ring owned by the calling thread, then returns. A single background thread drains
+/// every ring, formats the records with the same rules as `print`/`stringf` (`Format::write`) and
+/// writes them out through a `Format::Sink`, one `write(2)` per drained batch.
+///
+/// ### Call Sites
+/// The format string is a template argument, so it is validated at compile time against the
+/// argument types and every call site instantiates its own decoder; the address of that decoder
+/// is the site ID stored in each record.
+///
+/// \code{.cpp}
+/// Log::info<"request \{\} took \{\}ms">(id, elapsed);
+/// \endcode
+///
+/// ### Costs
+/// - arithmetic, character, pointer and other trivially copyable arguments are copied as bytes.
+/// - string arguments (`string`, `string_view`, `const char *`) are copied as their characters.
+/// - any other argument is copy constructed into the ring and destroyed after formatting, so a
+///   container argument costs its copy on the calling thread.
+///
+/// ### Notes
+/// - records larger than half a ring are dropped and counted in `dropped()`.
+/// - when a ring is full the producer waits for the consumer (`Overflow::Block`, the default) or
+///   drops the record (`Overflow::Drop`).
+/// - `flush()` waits until everything the calling thread logged has been written.
+namespace Log {
+enum class Level : u8 { Trace, Debug, Info, Warn, Error };
+
+enum class Overflow : u8 { Block, Drop };
+
+namespace _internal {
+    using decode_fn = void (*)(Format::Buffer &out, byte *payload);
+
+    /// every record starts 16 byte aligned with this header, a null `decode` marks padding that
+    /// skips to the start of the ring.
+    struct alignas(16) Header {
+        decode_fn decode;
+        usize     size;
+    };
+
+    constexpr usize align_up(usize n, usize align) noexcept { return (n + align - 1) & ~(align - 1); }
+
+    template <typename T>
+    concept Text = Format::StringLike<Meta::remove_cvref_t<T>>;
+
+    /// how an argument of type `T` is held in the ring.
+    template <typename T>
+    struct stored {
+        using type = Meta::remove_cvref_t<T>;
+    };
+
+    template <typename T>
+        requires Text<T>
+    struct stored<T> {
+        using type = LIBCXX_NAMESPACE::string_view;
+    };
+
+    template <typename T>
+    using stored_t = typename stored<T>::type;
+
+    template <typename T>
+    constexpr LIBCXX_NAMESPACE::string_view as_text(const T &value) noexcept {
+        if constexpr (LIBCXX_NAMESPACE::is_pointer_v<Meta::remove_cvref_t<T>>) {
+            return value != nullptr ? LIBCXX_NAMESPACE::string_view(value) : LIBCXX_NAMESPACE::string_view();
+        } else {
+            return LIBCXX_NAMESPACE::string_view(value);
+        }
+    }
+
+    template <typename T>
+    usize encoded_size(usize offset, const T &value) noexcept {
+        if constexpr (Text<T>) {
+            return align_up(offset, alignof(usize)) + sizeof(usize) + as_text(value).size();
+        } else {
+            using S = stored_t<T>;
+            static_assert(alignof(S) <= alignof(Header), "Log: over-aligned argument types are not supported");
+            return align_up(offset, alignof(S)) + sizeof(S);
+        }
+    }
+
+    template <typename T>
+    void encode(byte *record, usize &offset, T &&value) {
+        if constexpr (Text<T>) {
+            const LIBCXX_NAMESPACE::string_view text = as_text(value);
+            const usize                         size = text.size();
+
+            offset = align_up(offset, alignof(usize));
+            LIBCXX_NAMESPACE::memcpy(record + offset, &size, sizeof(usize));
+            LIBCXX_NAMESPACE::memcpy(record + offset + sizeof(usize), text.data(), size);
+            offset += sizeof(usize) + size;
+        } else {
+            using S = stored_t<T>;
+
+            offset = align_up(offset, alignof(S));
+            if constexpr (LIBCXX_NAMESPACE::is_trivially_copyable_v<S>) {
+                LIBCXX_NAMESPACE::memcpy(record + offset, &value, sizeof(S));
+            } else {
+                ::new (record + offset) S(H_STD_NAMESPACE::Memory::forward<T>(value));
+            }
+            offset += sizeof(S);
+        }
+    }
+
+    /// what `decode` hands to the formatter for a stored `S`, strings come back as a view into
+    /// the record and everything else as a reference to the stored object.
+    template <typename S>
+    using decoded_t = LIBCXX_NAMESPACE::conditional_t<Meta::same_as<S, LIBCXX_NAMESPACE::string_view>,
+                                                       LIBCXX_NAMESPACE::string_view,
+                                                       const S &>;
+
+    template <typename S>
+    decoded_t<S> decode_one(byte *record, usize &offset) noexcept {
+        if constexpr (Meta::same_as<S, LIBCXX_NAMESPACE::string_view>) {
+            usize size = 0;
+
+            offset = align_up(offset, alignof(usize));
+            LIBCXX_NAMESPACE::memcpy(&size, record + offset, sizeof(usize));
+
+            const char *data = reinterpret_cast<const char *>(record + offset + sizeof(usize));
+            offset += sizeof(usize) + size;
+
+            return {data, size};
+        } else {
+            offset = align_up(offset, alignof(S));
+
+            const S *value = LIBCXX_NAMESPACE::launder(reinterpret_cast<const S *>(record + offset));
+            offset += sizeof(S);
+
+            return *value;
+        }
+    }
+
+    constexpr LIBCXX_NAMESPACE::string_view level_name(Level level) noexcept {
+        switch (level) {
+            case Level::Trace:
+                return "[trace] ";
+            case Level::Debug:
+                return "[debug] ";
+            case Level::Info:
+                return "[info] ";
+            case Level::Warn:
+                return "[warn] ";
+            case Level::Error:
+                return "[error] ";
+        }
+
+        return "";
+    }
+
+    /// one instantiation per call site, `&Site<...>::decode` is the site ID.
+    template <Level L, Format::FixedString Fmt, typename... S>
+    struct Site {
+        static constexpr Format::FormatString<const S &...> format{Fmt.view()};
+
+        static void decode(Format::Buffer &out, [[maybe_unused]] byte *record) {
+            [[maybe_unused]] usize offset = sizeof(Header);
+
+            // braced initialization evaluates left to right, matching the encode order
+            const tuple<decoded_t<S>...> args{decode_one<S>(record, offset)...};
+
+            out.append(level_name(L));
+
+            [&]<usize... I>(LIBCXX_NAMESPACE::integer_sequence<usize, I...>) {
+                Format::format_to(out, format, static_cast<const S &>(LIBCXX_NAMESPACE::get<I>(args))...);
+
+                (LIBCXX_NAMESPACE::get<I>(args).~S(), ...);
+            }(LIBCXX_NAMESPACE::make_integer_sequence<usize, sizeof...(S)>{});
+
+            out.push_back('\n');
+        }
+    };
+
+    /// \class Ring
+    /// A single producer, single consumer byte ring. `m_tail` is only written by the owning
+    /// thread, `m_head` only by the consumer; each side caches the other's index.
+    class Ring {
+      public:
+        explicit Ring(usize capacity)
+            : m_capacity(LIBCXX_NAMESPACE::bit_ceil(capacity < 4096 ? usize(4096) : capacity))
+            , m_data(static_cast<byte *>(::operator new(m_capacity, LIBCXX_NAMESPACE::align_val_t(alignof(Header))))) {}
+
+        ~Ring() { ::operator delete(m_data, LIBCXX_NAMESPACE::align_val_t(alignof(Header))); }
+
+        Ring(const Ring &)            = delete;
+        Ring(Ring &&)                 = delete;
+        Ring &operator=(const Ring &) = delete;
+        Ring &operator=(Ring &&)      = delete;
+
+        [[nodiscard]] usize capacity() const noexcept { return m_capacity; }
+
+        /// reserve `size` contiguous bytes (a multiple of 16), returns null if the record was
+        /// dropped. must be followed by `commit`.
+        byte *acquire(usize size, Overflow overflow) noexcept {
+            const usize tail       = m_tail.load(LIBCXX_NAMESPACE::memory_order_relaxed);
+            const usize index      = tail & (m_capacity - 1);
+            const usize contiguous = m_capacity - index;
+            const usize needed     = size + (size > contiguous ? contiguous : 0);
+
+            while (tail + needed - m_head_cache > m_capacity) {
+                m_head_cache = m_head.load(LIBCXX_NAMESPACE::memory_order_acquire);
+
+                if (tail + needed - m_head_cache <= m_capacity) {
+                    break;
+                }
+
+                if (overflow == Overflow::Drop) {
+                    return nullptr;
+                }
+
+                LIBCXX_NAMESPACE::this_thread::yield();
+            }
+
+            if (size > contiguous) {
+                ::new (m_data + index) Header{nullptr, contiguous};
+                m_pending = tail + contiguous;
+                return m_data;
+            }
+
+            m_pending = tail;
+            return m_data + index;
+        }
+
+        void commit(usize size) noexcept {
+            m_tail.store(m_pending + size, LIBCXX_NAMESPACE::memory_order_release);
+        }
+
+        /// consumer side, format every published record into `out`. returns the bytes consumed.
+        usize drain(Format::Buffer &out) {
+            const usize begin = m_head.load(LIBCXX_NAMESPACE::memory_order_relaxed);
+            const usize tail  = m_tail.load(LIBCXX_NAMESPACE::memory_order_acquire);
+            usize       head  = begin;
+
+            while (head != tail) {
+                byte         *record = m_data + (head & (m_capacity - 1));
+                const Header *header = LIBCXX_NAMESPACE::launder(reinterpret_cast<Header *>(record));
+
+                if (header->decode != nullptr) {
+                    header->decode(out, record);
+                }
+
+                head += header->size;
+            }
+
+            m_head.store(head, LIBCXX_NAMESPACE::memory_order_release);
+            return head - begin;
+        }
+
+        [[nodiscard]] bool empty() const noexcept {
+            return m_head.load(LIBCXX_NAMESPACE::memory_order_acquire) ==
+                   m_tail.load(LIBCXX_NAMESPACE::memory_order_acquire);
+        }
+
+        LIBCXX_NAMESPACE::atomic<bool> closed{false};
+
+      private:
+        usize m_capacity;
+        byte *m_data;
+
+        alignas(64) LIBCXX_NAMESPACE::atomic<usize> m_head{0};
+        alignas(64) LIBCXX_NAMESPACE::atomic<usize> m_tail{0};
+        usize m_head_cache = 0;
+        usize m_pending    = 0;
+    };
+
+    /// \class Logger
+    /// Owns every ring and the consumer thread. Constructed on the first log call of the process
+    /// and destroyed at exit, after draining whatever is left.
+    class Logger {
+      public:
+        static Logger &instance() {
+            static Logger logger;
+            return logger;
+        }
+
+        Logger(const Logger &)            = delete;
+        Logger(Logger &&)                 = delete;
+        Logger &operator=(const Logger &) = delete;
+        Logger &operator=(Logger &&)      = delete;
+
+        ~Logger() {
+            m_running.store(false, LIBCXX_NAMESPACE::memory_order_release);
+
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+
+            for (Ring *ring : m_rings) {
+                delete ring;
+            }
+        }
+
+        Ring *attach() {
+            auto *ring = new Ring(capacity.load(LIBCXX_NAMESPACE::memory_order_relaxed));
+
+            LIBCXX_NAMESPACE::lock_guard<LIBCXX_NAMESPACE::mutex> guard(m_lock);
+            m_rings.push_back(ring);
+
+            if (!m_thread.joinable()) {
+                m_running.store(true, LIBCXX_NAMESPACE::memory_order_release);
+                m_thread = LIBCXX_NAMESPACE::thread([this] { run(); });
+            }
+
+            return ring;
+        }
+
+        /// number of completed consumer passes, used by `flush()`.
+        [[nodiscard]] usize passes() const noexcept { return m_passes.load(LIBCXX_NAMESPACE::memory_order_acquire); }
+
+        static inline LIBCXX_NAMESPACE::atomic<usize>    capacity{usize(1) << 18};
+        static inline LIBCXX_NAMESPACE::atomic<i32>      output{2};
+        static inline LIBCXX_NAMESPACE::atomic<Level>    threshold{Level::Info};
+        static inline LIBCXX_NAMESPACE::atomic<Overflow> overflow{Overflow::Block};
+        static inline LIBCXX_NAMESPACE::atomic<usize>    dropped{0};
+
+      private:
+        Logger() = default;
+
+        void run() {
+            Format::Sink  out(output.load(LIBCXX_NAMESPACE::memory_order_relaxed), Format::FlushPolicy::Size, usize(1) << 16);
+            LIBCXX_NAMESPACE::vector<Ring *> rings;
+            u32            idle = 0;
+
+            while (true) {
+                const bool stopping = !m_running.load(LIBCXX_NAMESPACE::memory_order_acquire);
+                usize      drained  = 0;
+
+                {
+                    LIBCXX_NAMESPACE::lock_guard<LIBCXX_NAMESPACE::mutex> guard(m_lock);
+
+                    // rings of exited threads are freed once they are empty
+                    LIBCXX_NAMESPACE::erase_if(m_rings, [](Ring *ring) {
+                        if (ring->closed.load(LIBCXX_NAMESPACE::memory_order_acquire) && ring->empty()) {
+                            delete ring;
+                            return true;
+                        }
+
+                        return false;
+                    });
+
+                    rings.assign(m_rings.begin(), m_rings.end());
+                }
+
+                for (Ring *ring : rings) {
+                    drained += ring->drain(out);
+                }
+
+                out.flush();
+                m_passes.fetch_add(1, LIBCXX_NAMESPACE::memory_order_release);
+
+                if (drained != 0) {
+                    idle = 0;
+                    continue;
+                }
+
+                if (stopping) {
+                    break;
+                }
+
+                // spin briefly after activity, then back off to sleeping
+                if (++idle < 64) {
+                    LIBCXX_NAMESPACE::this_thread::yield();
+                } else {
+                    LIBCXX_NAMESPACE::this_thread::sleep_for(LIBCXX_NAMESPACE::chrono::microseconds(500));
+                }
+            }
+        }
+
+        LIBCXX_NAMESPACE::mutex          m_lock;
+        LIBCXX_NAMESPACE::vector<Ring *>                   m_rings;
+        LIBCXX_NAMESPACE::thread         m_thread;
+        LIBCXX_NAMESPACE::atomic<bool>   m_running{false};
+        LIBCXX_NAMESPACE::atomic<usize>  m_passes{0};
+    };
+
+    /// the calling thread's ring, attached on first use and handed back to the consumer (which
+    /// frees it once drained) when the thread exits.
+    class Producer {
+      public:
+        Producer()
+            : ring(Logger::instance().attach()) {}
+
+        ~Producer() { ring->closed.store(true, LIBCXX_NAMESPACE::memory_order_release); }
+
+        Producer(const Producer &)            = delete;
+        Producer(Producer &&)                 = delete;
+        Producer &operator=(const Producer &) = delete;
+        Producer &operator=(Producer &&)      = delete;
+
+        Ring *ring;
+    };
+
+    inline Ring &ring() {
+        thread_local Producer producer;
+        return *producer.ring;
+    }
+
+    template <Level L, Format::FixedString Fmt, typename... Args>
+    void emit(Args &&...args) {
+        if (L < Logger::threshold.load(LIBCXX_NAMESPACE::memory_order_relaxed)) {
+            return;
+        }
+
+        using S = Site<L, Fmt, stored_t<Args>...>;
+
+        usize size = sizeof(Header);
+        ((size = encoded_size(size, args)), ...);
+        size = align_up(size, alignof(Header));
+
+        Ring &target = ring();
+
+        if (size > target.capacity() / 2) [[unlikely]] {
+            Logger::dropped.fetch_add(1, LIBCXX_NAMESPACE::memory_order_relaxed);
+            return;
+        }
+
+        byte *record = target.acquire(size, Logger::overflow.load(LIBCXX_NAMESPACE::memory_order_relaxed));
+
+        if (record == nullptr) [[unlikely]] {
+            Logger::dropped.fetch_add(1, LIBCXX_NAMESPACE::memory_order_relaxed);
+            return;
+        }
+
+        ::new (record) Header{&S::decode, size};
+
+        [[maybe_unused]] usize offset = sizeof(Header);
+        (encode(record, offset, H_STD_NAMESPACE::Memory::forward<Args>(args)), ...);
+
+        target.commit(size);
+    }
+}  // namespace _internal
+
+template <Format::FixedString Fmt, typename... Args>
+inline void trace(Args &&...args) {
+    _internal::emit<Level::Trace, Fmt>(H_STD_NAMESPACE::Memory::forward<Args>(args)...);
+}
+
+template <Format::FixedString Fmt, typename... Args>
+inline void debug(Args &&...args) {
+    _internal::emit<Level::Debug, Fmt>(H_STD_NAMESPACE::Memory::forward<Args>(args)...);
+}
+
+template <Format::FixedString Fmt, typename... Args>
+inline void info(Args &&...args) {
+    _internal::emit<Level::Info, Fmt>(H_STD_NAMESPACE::Memory::forward<Args>(args)...);
+}
+
+template <Format::FixedString Fmt, typename... Args>
+inline void warn(Args &&...args) {
+    _internal::emit<Level::Warn, Fmt>(H_STD_NAMESPACE::Memory::forward<Args>(args)...);
+}
+
+template <Format::FixedString Fmt, typename... Args>
+inline void error(Args &&...args) {
+    _internal::emit<Level::Error, Fmt>(H_STD_NAMESPACE::Memory::forward<Args>(args)...);
+}
+
+/// records below `level` are discarded on the calling thread before anything is copied.
+inline void set_level(Level level) noexcept {
+    _internal::Logger::threshold.store(level, LIBCXX_NAMESPACE::memory_order_relaxed);
+}
+
+/// what a producer does when its ring is full.
+inline void set_overflow(Overflow overflow) noexcept {
+    _internal::Logger::overflow.store(overflow, LIBCXX_NAMESPACE::memory_order_relaxed);
+}
+
+/// ring size in bytes for threads that have not logged yet, rounded up to a power of two.
+inline void set_ring_capacity(usize bytes) noexcept {
+    _internal::Logger::capacity.store(bytes, LIBCXX_NAMESPACE::memory_order_relaxed);
+}
+
+/// descriptor the consumer writes to (stderr by default), only honoured before the first log.
+inline void set_output(i32 fd) noexcept {
+    _internal::Logger::output.store(fd, LIBCXX_NAMESPACE::memory_order_relaxed);
+}
+
+/// number of records dropped because they were too large or their ring was full.
+inline usize dropped() noexcept {
+    return _internal::Logger::dropped.load(LIBCXX_NAMESPACE::memory_order_relaxed);
+}
+
+/// block until every record logged so far by the calling thread has been written.
+inline void flush() {
+    _internal::Ring   &ring   = _internal::ring();
+    _internal::Logger &logger = _internal::Logger::instance();
+
+    while (!ring.empty()) {
+        LIBCXX_NAMESPACE::this_thread::yield();
+    }
+
+    // the pass that drained the ring may still be writing, wait for the one after it to finish
+    const usize pass = logger.passes();
+    while (logger.passes() < pass + 2) {
+        LIBCXX_NAMESPACE::this_thread::yield();
+    }
+}
+}  // namespace Log
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
@@ -19,6 +19,7 @@
 #include "config.h"
 #include "libcxx.h"
 #include "meta.h"
+#include "primitives.h"
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -54,7 +55,279 @@ inline constexpr T exchange(T &obj, U &&new_value) noexcept
     obj         = forward<U>(new_value);
     return old_value;
 }
-}
+
+/// \brief the c++ side of `std::types::Allocator` (`pkgs/std/types.hlx`): `alloc`, `dealloc` and
+/// `realloc` with explicit sizes and alignments. allocators are held by value, so stateful ones
+/// (an arena) are handles to state that lives elsewhere.
+template <typename A>
+concept Allocator = requires(A &alloc, void *ptr, usize size, usize alignment) {
+    { alloc.alloc(size, alignment) } -> Meta::same_as<void *>;
+    { alloc.dealloc(ptr, size, alignment) };
+    { alloc.realloc(ptr, size, size, alignment) } -> Meta::same_as<void *>;
+};
+
+/// \class DefaultAllocator
+/// The global `operator new` and `operator delete`, stateless. Buffers from it may be handed
+/// between owners that only know `operator delete` (`String::builder` relies on this).
+struct DefaultAllocator {
+    [[nodiscard]] void *alloc(usize size, usize alignment) const {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return ::operator new(size, LIBCXX_NAMESPACE::align_val_t(alignment));
+        }
+
+        return ::operator new(size);
+    }
+
+    void dealloc(void *ptr, usize size, usize alignment) const noexcept {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, size, LIBCXX_NAMESPACE::align_val_t(alignment));
+        } else {
+            ::operator delete(ptr, size);
+        }
+    }
+
+    [[nodiscard]] void *realloc(void *ptr, usize old_size, usize new_size, usize alignment) const {
+        void *block = alloc(new_size, alignment);
+
+        if (ptr != nullptr) {
+            LIBCXX_NAMESPACE::memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+            dealloc(ptr, old_size, alignment);
+        }
+
+        return block;
+    }
+
+    friend constexpr bool operator==(DefaultAllocator, DefaultAllocator) noexcept { return true; }
+};
+
+/// \class Arena
+///
+/// A bump allocator for memory that dies together: per request string churn, scratch buffers.
+/// Allocating is a pointer bump, freeing one block does nothing (unless it was the last one
+/// handed out, which is taken back, or has a side chunk of its own, which is freed), and
+/// `reset()` frees everything at once.
+///
+/// ### Design Details
+/// - **Chunks**: memory comes from the heap in chunks that double in size, starting at
+///   `initial`. A request larger than the next chunk would be gets a chunk of its own on the
+///   side, which is neither bumped from afterwards nor counted in the doubling, so one large
+///   block does not inflate every later chunk.
+/// - **Growth in place**: `realloc` of the last block extends it when the chunk has room, so a
+///   string growing in an arena (`String::basic` grows through `realloc`) usually does not copy;
+///   moving a block out of a side chunk frees that chunk, so large blocks are not left behind.
+/// - **Reset**: `reset()` returns every chunk but the current (largest) one, which is kept for
+///   reuse, and all side chunks; the destructor returns all of them.
+/// - Not thread safe; use one arena per thread or per request. `ArenaAllocator` is the handle
+///   containers hold, the arena must outlive them.
+class Arena {
+  public:
+    explicit Arena(usize initial = 4096) noexcept
+        : m_initial(initial < 64 ? 64 : initial) {}
+
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() { release(nullptr); }
+
+    [[nodiscard]] void *alloc(usize size, usize alignment) {
+        char *start = align(m_next, alignment);
+
+        if (m_chunk == nullptr || static_cast<usize>(start - m_next) + size > static_cast<usize>(m_end - m_next)) {
+            if (size + alignment > next_size()) {
+                return align(side(size + alignment)->bytes(), alignment);
+            }
+
+            grow();
+            start = align(m_next, alignment);
+        }
+
+        m_last = start;
+        m_next = start + size;
+
+        return start;
+    }
+
+    void dealloc(void *ptr, usize size, usize /* alignment */) noexcept {
+        if (ptr != nullptr && ptr == m_last && static_cast<char *>(ptr) + size == m_next) {
+            m_next = m_last;  // the most recent block, take it back
+            m_last = nullptr;
+        } else if (Chunk *chunk = side_of(ptr); chunk != nullptr) {
+            drop_side(chunk);
+        }
+    }
+
+    [[nodiscard]] void *realloc(void *ptr, usize old_size, usize new_size, usize alignment) {
+        if (ptr != nullptr && ptr == m_last && new_size <= static_cast<usize>(m_end - m_last)) {
+            m_next = static_cast<char *>(ptr) + new_size;
+            return ptr;
+        }
+
+        Chunk *side  = side_of(ptr);
+        void  *block = alloc(new_size, alignment);
+
+        if (ptr != nullptr) {
+            LIBCXX_NAMESPACE::memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+        }
+
+        if (side != nullptr) {
+            drop_side(side);  // held nothing but the old block
+        }
+
+        return block;
+    }
+
+    /// free everything handed out so far in one go, keeping the current chunk for reuse.
+    void reset() noexcept {
+        Chunk *keep = m_chunk;  // the newest chunk is the largest, side chunks aside
+
+        release(keep);
+
+        if (keep != nullptr) {
+            keep->next = nullptr;
+            m_next     = keep->bytes();
+            m_last     = nullptr;
+        }
+    }
+
+    /// bytes handed out from the current chunk, a rough measure of how much is in use.
+    [[nodiscard]] usize used() const noexcept { return m_chunk != nullptr ? static_cast<usize>(m_next - m_chunk->bytes()) : 0; }
+
+    /// bytes held from the heap across every chunk, side chunks included.
+    [[nodiscard]] usize reserved() const noexcept {
+        usize total = 0;
+
+        for (const Chunk *list : {m_chunk, m_side}) {
+            for (const Chunk *chunk = list; chunk != nullptr; chunk = chunk->next) {
+                total += chunk->size;
+            }
+        }
+
+        return total;
+    }
+
+  private:
+    struct Chunk {
+        Chunk *next;
+        usize  size;
+
+        char *bytes() noexcept { return reinterpret_cast<char *>(this + 1); }
+    };
+
+    static char *align(char *ptr, usize alignment) noexcept {
+        const auto address = reinterpret_cast<usize>(ptr);
+        return reinterpret_cast<char *>((address + alignment - 1) & ~(alignment - 1));
+    }
+
+    [[nodiscard]] usize next_size() const noexcept { return m_chunk != nullptr ? m_chunk->size * 2 : m_initial; }
+
+    static Chunk *make_chunk(usize size, Chunk *next) {
+        auto *chunk = static_cast<Chunk *>(::operator new(sizeof(Chunk) + size));
+        chunk->next = next;
+        chunk->size = size;
+
+        return chunk;
+    }
+
+    /// a new current chunk, twice the size of the last one.
+    void grow() {
+        const usize size  = next_size();
+        Chunk      *chunk = make_chunk(size, m_chunk);
+
+        m_chunk = chunk;
+        m_next  = chunk->bytes();
+        m_end   = m_next + size;
+        m_last  = nullptr;
+    }
+
+    /// a chunk of exactly `size` bytes for one large request, the current chunk stays as it is.
+    Chunk *side(usize size) {
+        m_side = make_chunk(size, m_side);
+        return m_side;
+    }
+
+    /// the side chunk holding `ptr`, null when it is not in one; side chunks hold one block each.
+    Chunk *side_of(const void *ptr) const noexcept {
+        const auto address = reinterpret_cast<usize>(ptr);
+
+        for (Chunk *chunk = m_side; ptr != nullptr && chunk != nullptr; chunk = chunk->next) {
+            const auto start = reinterpret_cast<usize>(chunk->bytes());
+
+            if (address >= start && address < start + chunk->size) {
+                return chunk;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void drop_side(Chunk *chunk) noexcept {
+        Chunk **link = &m_side;
+        while (*link != chunk) {
+            link = &(*link)->next;
+        }
+
+        *link = chunk->next;
+        ::operator delete(chunk);
+    }
+
+    /// free every chunk except `keep`, side chunks included.
+    void release(Chunk *keep) noexcept {
+        for (Chunk *chunk = m_chunk; chunk != nullptr;) {
+            Chunk *next = chunk->next;
+
+            if (chunk != keep) {
+                ::operator delete(chunk);
+            }
+
+            chunk = next;
+        }
+
+        for (Chunk *chunk = m_side; chunk != nullptr;) {
+            Chunk *next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+
+        m_side = nullptr;
+
+        if (keep == nullptr) {
+            m_chunk = nullptr;
+            m_next  = nullptr;
+            m_end   = nullptr;
+            m_last  = nullptr;
+        }
+    }
+
+    Chunk *m_chunk = nullptr;
+    Chunk *m_side  = nullptr;
+    char  *m_next  = nullptr;
+    char  *m_end   = nullptr;
+    char  *m_last  = nullptr;
+    usize  m_initial;
+};
+
+/// \class ArenaAllocator
+/// A handle to an `Arena` that satisfies `Allocator`, copies share the arena.
+class ArenaAllocator {
+  public:
+    ArenaAllocator(Arena &arena) noexcept  // NOLINT(google-explicit-constructor)
+        : m_arena(&arena) {}
+
+    [[nodiscard]] void *alloc(usize size, usize alignment) const { return m_arena->alloc(size, alignment); }
+    void dealloc(void *ptr, usize size, usize alignment) const noexcept { m_arena->dealloc(ptr, size, alignment); }
+
+    [[nodiscard]] void *realloc(void *ptr, usize old_size, usize new_size, usize alignment) const {
+        return m_arena->realloc(ptr, old_size, new_size, alignment);
+    }
+
+    [[nodiscard]] Arena &arena() const noexcept { return *m_arena; }
+
+    friend bool operator==(const ArenaAllocator &lhs, const ArenaAllocator &rhs) noexcept { return lhs.m_arena == rhs.m_arena; }
+
+  private:
+    Arena *m_arena;
+};
+}  // namespace Memory
 
 H_STD_NAMESPACE_END
 H_NAMESPACE_END
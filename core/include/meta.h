@@ -128,6 +128,11 @@ struct remove_cvref {
     using type = typename remove_const_volatile<typename remove_reference<T>::type>::type;
 };
 
+template <typename T>
+struct type_identity {
+    using type = T;
+};
+
 template <typename T>
 struct reference_to_pointer {
     using type = T;
@@ -283,6 +288,14 @@ using remove_cvref_t = typename _types::remove_cvref<T>::type;
 template <typename T>
 using reference_to_pointer_t = typename _types::reference_to_pointer<T>::type;
 
+/// blocks template argument deduction for `T` when used in a function parameter
+template <typename T>
+using type_identity_t = typename _types::type_identity<T>::type;
+
+/// the last type of a pack, `void` for an empty pack
+template <typename... T>
+using last_t = typename decltype((_types::type_identity<void>{}, ..., _types::type_identity<T>{}))::type;
+
 template <class T>
 using add_const_t = typename _types::add_const<T>::type;
 
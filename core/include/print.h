@@ -18,11 +18,17 @@
 
 #include "interfaces.h"
 #include "config.h"
+#include "demangle.h"
 #include "types.h"
 #include "libc.h"
 #include "memory.h"
 #include "meta.h"
 #include "primitives.h"
+#include "print/buffer.h"
+#include "print/format.h"
+#include "print/mapped.h"
+#include "print/numeric.h"
+#include "print/sink.h"
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -51,6 +57,8 @@ class endl {
         return oss;
     }
 
+    [[nodiscard]] const string &get() const noexcept { return end_l; }
+
   private:
     string end_l = "\n";
 };
@@ -59,39 +67,83 @@ class endl {
 /// \brief convert any type to a string
 ///
 /// This function will try to convert the argument to a string using the following methods:
-/// - if the argument has a to_string method, it will use that
+/// - if the argument is a bool, a character, a string or an arithmetic type, it is written
+///   directly (see `Format::write_number`), numbers never go through a stream
+/// - if the argument is `Interfaces::Formattable`, it appends itself into the result
 /// - if the argument has a ostream operator, it will use that
-/// - if the argument is an arithmetic type, it will use H_STD_NAMESPACE::to_string
+/// - if the argument has a to_string method, it will use that
 /// - if all else fails, it will convert the address of the argument to a string
 ///
 template <typename Ty>
 constexpr string to_string(Ty &&t) {
-    if constexpr (H_STD_NAMESPACE::Interfaces::SupportsOStream<Ty>) {
+    using U = H_STD_NAMESPACE::Meta::remove_cvref_t<Ty>;
+
+    if constexpr (H_STD_NAMESPACE::Meta::same_as<U, char>) {
+        return string(1, t);
+    } else if constexpr (LIBCXX_NAMESPACE::is_arithmetic_v<U>) {
+        char digits[Format::max_chars<U>];
+        return string(digits, Format::write_number(digits, static_cast<U>(t)));
+    } else if constexpr (Format::StringLike<U> && !LIBCXX_NAMESPACE::is_pointer_v<U>) {
+        return string(LIBCXX_NAMESPACE::string_view(t));
+    } else if constexpr (H_STD_NAMESPACE::Interfaces::Formattable<U>) {
+        string result;
+        {
+            Format::StringBuffer out(result);
+            Format::write(out, t);
+        }
+
+        return result;
+    } else if constexpr (H_STD_NAMESPACE::Interfaces::SupportsOStream<Ty>) {
         LIBCXX_NAMESPACE::stringstream ss;
         ss << t;
         return ss.str();
     } else if constexpr (H_STD_NAMESPACE::Interfaces::Castable<Ty, string>) {
         return t.operator$cast(static_cast<string *>(nullptr));
-    } else if constexpr (H_STD_NAMESPACE::Meta::same_as<Ty, bool>) {
-        return t ? "true" : "false";
-    } else if constexpr (LIBCXX_NAMESPACE::is_arithmetic_v<Ty>) {
-        return LIBCXX_NAMESPACE::to_string(t);
     } else {
-        LIBCXX_NAMESPACE::stringstream ss;
+        const LIBCXX_NAMESPACE::string_view name = H_STD_NAMESPACE::demangle(typeid(t));
 
-#ifdef _MSC_VER
-        ss << "[" << typeid(t).name() << " at 0x" << LIBCXX_NAMESPACE::hex << &t << "]";
-#else
-        int   st;
-        char *rn = libc::abi::__cxa_demangle(typeid(t).name(), 0, 0, &st);
-        ss << "[" << rn << " at 0x" << LIBCXX_NAMESPACE::hex << &t << "]";
-        free(rn);
-#endif
+        char       address[2 + 2 * sizeof(void *)] = {'0', 'x'};
+        const auto addr = LIBCXX_NAMESPACE::to_chars(
+            address + 2, address + sizeof(address), reinterpret_cast<LIBCXX_NAMESPACE::uintptr_t>(&t), 16);
 
-        return ss.str();
+        string result;
+        result.reserve(name.size() + 6 + sizeof(address));
+
+        result += '[';
+        result += name;
+        result += " at ";
+        result.append(address, addr.ptr);
+        result += ']';
+
+        return result;
     }
 }
 
+/// \include belongs to the helix standard library.
+/// \brief convert `t` to a string inside caller provided storage `[first, last)`
+///
+/// the same conversion as `to_string`, but nothing is allocated for characters, strings and
+/// numbers. the result is not null terminated. if the text does not fit, as much as fits is
+/// written and `ec` is `errc::value_too_large`.
+///
+/// \code{.cpp}
+/// char buf[Format::max_chars<i64>];
+/// auto [end, ec] = to_string_into(buf, buf + sizeof(buf), -42);  // "-42"
+/// \endcode
+///
+template <typename Ty>
+LIBCXX_NAMESPACE::to_chars_result to_string_into(char *first, char *last, Ty &&t) {
+    Format::FixedBuffer out(first, static_cast<usize>(last - first));
+    Format::write(out, H_STD_NAMESPACE::Memory::forward<Ty>(t));
+
+    return {first + out.size(), out.truncated() ? LIBCXX_NAMESPACE::errc::value_too_large : LIBCXX_NAMESPACE::errc{}};
+}
+
+template <usize N, typename Ty>
+LIBCXX_NAMESPACE::to_chars_result to_string_into(char (&buffer)[N], Ty &&t) {
+    return to_string_into(buffer, buffer + N, H_STD_NAMESPACE::Memory::forward<Ty>(t));
+}
+
 /// \include belongs to the helix standard library.
 /// \brief format a string with arguments
 ///
@@ -105,51 +157,121 @@ constexpr string to_string(Ty &&t) {
 /// f"hi: {(some_expr() + 12)=}" -> stringf("hi: (some_expr() + 12)=\{\}", some_expr())
 /// f"hi: {some_expr() + 12}"    -> stringf("hi: \{\}", some_expr() + 12)
 ///
+/// placeholders take an optional format specifier for width, alignment, precision and radix:
+///
+/// stringf("\{:>8\} | \{:.3f\} | \{:#x\}", name, ratio, flags)
+///
+/// the format string is parsed at compile time (see `Format::FormatString`), a placeholder count
+/// that does not match the argument count, or a specifier that does not fit its argument, is a
+/// compile error. the result is sized once from the literal length, the specifier widths and the
+/// argument size hints, then every piece is written into it in order.
+///
+/// strings only known at runtime can be passed as `Format::runtime(s)`, a mismatch then throws.
+///
 template <typename... Ty>
-constexpr string stringf(string s, Ty &&...t) {
-    const array<string, sizeof...(t)> EAS = {to_string(H_STD_NAMESPACE::Memory::forward<Ty>(t))...};
+string stringf(Format::FormatString<Meta::type_identity_t<Ty>...> fmt, Ty &&...t) {
+    string result;
 
-    usize pos = 0;
-
-#ifdef __GNUG__
-#pragma unroll
-#endif
+    {
+        Format::StringBuffer out(result,
+                                 fmt.literal_size() + fmt.padding_size() + (Format::size_hint(t) + ... + usize(0)));
+        Format::format_to(out, fmt, H_STD_NAMESPACE::Memory::forward<Ty>(t)...);
+    }
 
-    for (auto &&arg : EAS) {
-        pos = s.find("\\{\\}", pos);
+    return result;
+}
 
-        if (pos == string::npos) [[unlikely]] {
-            throw LIBCXX_NAMESPACE::runtime_error(
-                "error: [f-stirng engine]: format argument count mismatch, this should not "
-                "happen, please open a issue on github");
-        }
+/// \include belongs to the helix standard library.
+/// \brief format a template with named placeholders.
+///
+/// mapped_format<"hello {name}, \{n\} is {n:#x}">(Format::arg<"name">(user), Format::arg<"n">(n))
+///
+/// the template is a constant, so every `{name}` is resolved to its argument while compiling
+/// (an unknown name or an unfitting specifier is a compile error) and the call costs the same
+/// as the equivalent positional `stringf`. `{{` and `}}` are literal braces.
+///
+/// for templates only known at runtime build a `Format::Template` once and reuse it, or pass
+/// `Format::runtime(s)` here for a one-off call.
+///
+template <Format::FixedString Fmt, typename... Named>
+string mapped_format(const Named &...args) {
+    string result;
 
-        s.replace(pos, 4, arg);
-        pos += arg.size();
+    {
+        Format::StringBuffer out(result,
+                                 Format::_mapped::Plan<Fmt, Named...>::estimate +
+                                     (Format::size_hint(args.value) + ... + usize(0)));
+        Format::mapped_format_to<Fmt>(out, args...);
     }
 
-    return s;
+    return result;
+}
+
+/// \include belongs to the helix standard library.
+/// \brief format a runtime template with named placeholders, see `Format::Template` for reuse.
+template <typename... Named>
+string mapped_format(Format::RuntimeString fmt, const Named &...args) {
+    const LIBCXX_NAMESPACE::string_view names[] = {Named::name..., {}};
+    const Format::Template              tpl(fmt.str, names, sizeof...(Named));
+
+    return tpl.format(args.value...);
 }
 
+/// \include belongs to the helix standard library.
+/// \brief write `value` and a newline to a file descriptor through a fixed-size buffer.
+///
+/// std::stream(huge_map, {.fd = log_fd, .max_elements = 1000});
+///
+/// containers emit their elements straight into the buffer and each full buffer is written out,
+/// so dumping a container of any size never holds more than `options.buffer_size` bytes of
+/// output, whatever flush policy `print` is using. output already buffered by `print` on this
+/// thread is flushed first when writing to standard output, so the two keep their order.
+template <typename T>
+void stream(const T &value, Format::StreamOptions options = {}) {
+    if (options.fd == 1) {
+        Format::stdout_sink().flush();
+    }
+
+    Format::Sink out(options.fd, Format::FlushPolicy::Size, options.buffer_size);
+    out.set_element_limit(options.max_elements);
+
+    Format::write(out, value);
+    out.push_back('\n');
+}  // `out` flushes the rest here
+
+/// \include belongs to the helix standard library.
+/// \brief write everything `print` has buffered on the calling thread to standard output.
+///
+/// must be called before terminating abnormally (the panic handler does), normal exit flushes
+/// on its own.
+inline void flush() { Format::stdout_sink().flush(); }
+
+/// \include belongs to the helix standard library.
+/// \brief change when `print` output on the calling thread reaches standard output.
+inline void set_flush_policy(Format::FlushPolicy policy) { Format::stdout_sink().set_policy(policy); }
+
 H_STD_NAMESPACE_END
 
+/// \include belongs to the helix standard library.
+/// \brief print the arguments to standard output followed by a newline.
+///
+/// the arguments are formatted straight into the calling thread's output sink (see
+/// `Format::stdout_sink`), which reaches the descriptor according to its `Format::FlushPolicy`.
+/// the trailing newline is left out when the last argument is a `std::endl`, that check is made
+/// on the argument types alone.
 template <typename... Args>
-inline constexpr void print(Args &&...t) {
-    if constexpr (sizeof...(t) == 0) {
-        printf("\n");
-        return;
-    }
+inline void print(Args &&...t) {
+    auto &out = H_STD_NAMESPACE::Format::stdout_sink();
 
-    ((printf("%s", H_STD_NAMESPACE::to_string(H_STD_NAMESPACE::Memory::forward<Args>(t)).c_str())), ...);
+    (H_STD_NAMESPACE::Format::write(out, H_STD_NAMESPACE::Memory::forward<Args>(t)), ...);
 
-    if constexpr (sizeof...(t) > 0) {
-        if constexpr (!H_STD_NAMESPACE::Meta::same_as<
-                          H_STD_NAMESPACE::Meta::remove_const_volatile_t<H_STD_NAMESPACE::Meta::remove_reference_t<
-                              decltype(LIBCXX_NAMESPACE::get<sizeof...(t) - 1>(tuple<Args...>(t...)))>>,
-                          H_STD_NAMESPACE::endl>) {
-            printf("\n");
-        }
+    if constexpr (!H_STD_NAMESPACE::Meta::same_as<
+                      H_STD_NAMESPACE::Meta::remove_cvref_t<H_STD_NAMESPACE::Meta::last_t<Args...>>,
+                      H_STD_NAMESPACE::endl>) {
+        out.push_back('\n');
     }
+
+    out.commit();
 }
 
 H_NAMESPACE_END
@@ -0,0 +1,262 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_BUFFER__
+#define __$LIBHELIX_PRINT_BUFFER__
+
+#include "../config.h"
+#include "../libcxx.h"
+#include "../primitives.h"
+
+H_NAMESPACE_BEGIN
+
+using string = LIBCXX_NAMESPACE::string;
+
+H_STD_NAMESPACE_BEGIN
+
+namespace Format {
+/// \class Buffer
+///
+/// `Buffer` is the single output target of the formatting layer. Every formatter in helix
+/// (`stringf`, `print`, `to_string`) writes into a `Buffer` rather than returning temporaries,
+/// so the cost of producing output is one `memcpy` per piece and one growth per capacity
+/// exhaustion.
+///
+/// ### Design Details
+/// - **Non-virtual**: the only customization point is a single `grow` function pointer, called
+///   when the buffer runs out of capacity. Appending never goes through an indirect call on the
+///   fast path.
+/// - **Grow semantics**: a grow hook may either enlarge the storage (`StringBuffer`) or drain it
+///   (an output sink that flushes to a file descriptor). A hook that can do neither leaves the
+///   buffer full, and the remaining bytes are dropped; `FixedBuffer` uses this for caller-owned
+///   storage.
+///
+/// ### Example
+/// \code{.cpp}
+/// string out;
+/// {
+///     Format::StringBuffer buf(out, 64);
+///     buf.append("value: ");
+///     Format::write(buf, 42);
+/// }   // `out` is "value: 42"
+/// \endcode
+class Buffer {
+  public:
+    static constexpr usize unlimited = static_cast<usize>(-1);
+
+    Buffer(const Buffer &)            = delete;
+    Buffer(Buffer &&)                 = delete;
+    Buffer &operator=(const Buffer &) = delete;
+    Buffer &operator=(Buffer &&)      = delete;
+
+    [[nodiscard]] constexpr usize       size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr usize       capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] constexpr char       *data() noexcept { return m_data; }
+    [[nodiscard]] constexpr const char *data() const noexcept { return m_data; }
+
+    constexpr void clear() noexcept { m_size = 0; }
+
+    /// how many elements a container formatted into this buffer writes before eliding the rest,
+    /// applies at every nesting level.
+    [[nodiscard]] constexpr usize element_limit() const noexcept { return m_limit; }
+    constexpr void                set_element_limit(usize limit) noexcept { m_limit = limit; }
+
+    /// make room for at least `n` more bytes, this is only a request; sinks may flush instead.
+    void reserve(usize n) {
+        if (m_size + n > m_capacity) [[unlikely]] {
+            m_grow(*this, m_size + n);
+        }
+    }
+
+    void push_back(char c) {
+        if (m_size == m_capacity) [[unlikely]] {
+            m_grow(*this, m_size + 1);
+
+            if (m_size == m_capacity) [[unlikely]] {
+                return;
+            }
+        }
+
+        m_data[m_size++] = c;
+    }
+
+    void append(const char *str, usize n) {
+        while (n != 0) {
+            if (m_size == m_capacity) [[unlikely]] {
+                m_grow(*this, m_size + n);
+
+                if (m_size == m_capacity) [[unlikely]] {
+                    return;
+                }
+            }
+
+            const usize chunk = (n < m_capacity - m_size) ? n : (m_capacity - m_size);
+            LIBCXX_NAMESPACE::memcpy(m_data + m_size, str, chunk);
+
+            m_size += chunk;
+            str    += chunk;
+            n      -= chunk;
+        }
+    }
+
+    void append(LIBCXX_NAMESPACE::string_view str) { append(str.data(), str.size()); }
+
+    /// append `n` copies of `c`, used for padding and alignment.
+    void fill(char c, usize n) {
+        while (n != 0) {
+            if (m_size == m_capacity) [[unlikely]] {
+                m_grow(*this, m_size + n);
+
+                if (m_size == m_capacity) [[unlikely]] {
+                    return;
+                }
+            }
+
+            const usize chunk = (n < m_capacity - m_size) ? n : (m_capacity - m_size);
+            LIBCXX_NAMESPACE::memset(m_data + m_size, c, chunk);
+
+            m_size += chunk;
+            n      -= chunk;
+        }
+    }
+
+  protected:
+    using grow_fn = void (*)(Buffer &, usize);
+
+    constexpr explicit Buffer(grow_fn grow, char *data = nullptr, usize size = 0, usize capacity = 0) noexcept
+        : m_data(data)
+        , m_size(size)
+        , m_capacity(capacity)
+        , m_grow(grow) {}
+
+    ~Buffer() = default;
+
+    constexpr void set(char *data, usize capacity) noexcept {
+        m_data     = data;
+        m_capacity = capacity;
+    }
+
+    constexpr void resize(usize size) noexcept { m_size = size; }
+
+  private:
+    char   *m_data;
+    usize   m_size;
+    usize   m_capacity;
+    grow_fn m_grow;
+    usize   m_limit = unlimited;
+};
+
+/// \class StringBuffer
+///
+/// A `Buffer` that appends to an existing `string`. The string is sized once up front (from the
+/// `reserve` hint), grows geometrically when the hint was too small, and is trimmed back to the
+/// written length when the buffer is destroyed.
+class StringBuffer final : public Buffer {
+  public:
+    explicit StringBuffer(string &out, usize reserve = 0)
+        : Buffer(grow, nullptr, out.size(), out.size())
+        , m_out(out) {
+        if (reserve != 0) {
+            grow(*this, out.size() + reserve);
+        }
+    }
+
+    ~StringBuffer() { m_out.resize(size()); }
+
+    StringBuffer(const StringBuffer &)            = delete;
+    StringBuffer(StringBuffer &&)                 = delete;
+    StringBuffer &operator=(const StringBuffer &) = delete;
+    StringBuffer &operator=(StringBuffer &&)      = delete;
+
+  private:
+    static void grow(Buffer &buf, usize requested) {
+        auto &self = static_cast<StringBuffer &>(buf);
+
+        usize capacity = self.capacity() + (self.capacity() >> 1);
+        if (capacity < requested) {
+            capacity = requested;
+        }
+
+        if (capacity < 32) {
+            capacity = 32;
+        }
+
+        self.m_out.resize(capacity);
+        self.set(self.m_out.data(), capacity);
+    }
+
+    string &m_out;
+};
+
+/// \class Appender
+///
+/// An output iterator over a `Buffer`, for formatting code written against iterators
+/// (`LIBCXX_NAMESPACE::copy`, `to_chars` style loops, ...). Every assignment is a `push_back`.
+class Appender {
+  public:
+    using iterator_category = LIBCXX_NAMESPACE::output_iterator_tag;
+    using value_type        = void;
+    using difference_type   = isize;
+    using pointer           = void;
+    using reference         = void;
+
+    constexpr explicit Appender(Buffer &out) noexcept
+        : m_out(&out) {}
+
+    Appender &operator=(char c) {
+        m_out->push_back(c);
+        return *this;
+    }
+
+    constexpr Appender &operator*() noexcept { return *this; }
+    constexpr Appender &operator++() noexcept { return *this; }
+    constexpr Appender  operator++(int) noexcept { return *this; }
+
+    [[nodiscard]] constexpr Buffer &buffer() const noexcept { return *m_out; }
+
+  private:
+    Buffer *m_out;
+};
+
+/// \class FixedBuffer
+///
+/// A `Buffer` over caller-owned storage. It never allocates; output that does not fit is
+/// dropped and reported through `truncated()`.
+class FixedBuffer final : public Buffer {
+  public:
+    constexpr FixedBuffer(char *data, usize capacity) noexcept
+        : Buffer(grow, data, 0, capacity) {}
+
+    ~FixedBuffer() = default;
+
+    FixedBuffer(const FixedBuffer &)            = delete;
+    FixedBuffer(FixedBuffer &&)                 = delete;
+    FixedBuffer &operator=(const FixedBuffer &) = delete;
+    FixedBuffer &operator=(FixedBuffer &&)      = delete;
+
+    [[nodiscard]] constexpr bool truncated() const noexcept { return m_truncated; }
+
+  private:
+    static void grow(Buffer &buf, usize /* requested */) {
+        static_cast<FixedBuffer &>(buf).m_truncated = true;
+    }
+
+    bool m_truncated = false;
+};
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
@@ -0,0 +1,301 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_FORMAT__
+#define __$LIBHELIX_PRINT_FORMAT__
+
+#include "../config.h"
+#include "../interfaces.h"
+#include "../libcxx.h"
+#include "../memory.h"
+#include "../meta.h"
+#include "../primitives.h"
+#include "../types.h"
+#include "buffer.h"
+#include "numeric.h"
+#include "spec.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+class endl;  // forward declaration
+
+namespace Format {
+/// \struct Segment
+/// A run of literal text inside a format string, stored as an offset and length so a parsed
+/// format string never owns or copies its text.
+struct Segment {
+    usize offset = 0;
+    usize length = 0;
+};
+
+/// \struct RuntimeString
+/// Opt-out for format strings that are not known at compile time, see `Format::runtime`.
+struct RuntimeString {
+    LIBCXX_NAMESPACE::string_view str;
+};
+
+/// wrap a format string that is only known at runtime, the placeholder count is then validated
+/// when the call is made instead of at compile time.
+inline RuntimeString runtime(LIBCXX_NAMESPACE::string_view str) noexcept { return {str}; }
+
+/// \class FormatString
+///
+/// A format string whose placeholders have been resolved against the argument types `Args...`.
+///
+/// ### Placeholders
+/// The helix compiler lowers f-strings to a literal with escaped placeholders:
+///
+/// f"hi: {var}"   -> stringf("hi: \{\}", var)
+///
+/// so the placeholder in the c++ string is the 4 character sequence `\{\}`. Any other text
+/// (including bare braces) is literal. A placeholder may carry a format specifier,
+/// `\{:>8\}`, `\{:.3f\}`, `\{:#x\}` (see `Format::Spec` for the full syntax).
+///
+/// ### Design Details
+/// - **Compile-time parsing**: the constructor is `consteval`; the string is split into
+///   `sizeof...(Args) + 1` literal segments (the text before each argument, plus the trailing
+///   text) while the program compiles.
+/// - **Compile-time validation**: a placeholder/argument count mismatch, or a specifier that does
+///   not apply to its argument's type, is a compile error at the call site rather than a runtime
+///   exception.
+/// - **Parsed specifiers**: each placeholder's specifier is parsed once into a `Spec`, writing an
+///   argument only reads the already decoded fields.
+/// - **Size estimate**: the total literal length is computed once during parsing and used by
+///   `stringf` to size its output before any argument is written.
+template <typename... Args>
+class FormatString {
+  public:
+    static constexpr usize arg_count = sizeof...(Args);
+
+    template <typename S>
+        requires H_STD_NAMESPACE::Meta::convertible_to<const S &, LIBCXX_NAMESPACE::string_view>
+    consteval FormatString(const S &str)  // NOLINT(google-explicit-constructor)
+        : m_str(str) {
+        parse();
+    }
+
+    FormatString(RuntimeString str)  // NOLINT(google-explicit-constructor)
+        : m_str(str.str) {
+        parse();
+    }
+
+    [[nodiscard]] constexpr LIBCXX_NAMESPACE::string_view get() const noexcept { return m_str; }
+    [[nodiscard]] constexpr usize literal_size() const noexcept { return m_literal_size; }
+
+    /// the sum of all specifier widths, the most padding a call can add.
+    [[nodiscard]] constexpr usize padding_size() const noexcept { return m_padding_size; }
+
+    /// the specifier of argument `idx`, empty for a plain placeholder.
+    [[nodiscard]] constexpr const Spec &spec(usize idx) const noexcept { return m_specs[idx]; }
+
+    /// the literal text preceding argument `idx`; `literal(arg_count)` is the trailing text.
+    [[nodiscard]] constexpr LIBCXX_NAMESPACE::string_view literal(usize idx) const noexcept {
+        return {m_str.data() + m_segments[idx].offset, m_segments[idx].length};
+    }
+
+  private:
+    static constexpr Kind kind(usize idx) noexcept {
+        constexpr Kind kinds[] = {kind_of<Args>()..., Kind::Other};
+        return kinds[idx];
+    }
+
+    constexpr void parse() {
+        const usize size  = m_str.size();
+        usize       arg   = 0;
+        usize       begin = 0;
+        usize       pos   = 0;
+
+        while (pos + 1 < size) {
+            if (m_str[pos] != '\\' || m_str[pos + 1] != '{') {
+                ++pos;
+                continue;
+            }
+
+            usize close = pos + 2;
+            while (close + 1 < size && (m_str[close] != '\\' || m_str[close + 1] != '}')) {
+                ++close;
+            }
+
+            if (close + 1 >= size) {
+                _format_error("error: [f-string engine]: unterminated '\\{' in format string");
+            }
+
+            if (arg == arg_count) {
+                _format_error("error: [f-string engine]: format string has more placeholders "
+                              "than arguments");
+            }
+
+            m_specs[arg]    = parse_spec(m_str.substr(pos + 2, close - pos - 2), kind(arg));
+            m_padding_size += m_specs[arg].width;
+
+            m_segments[arg++] = {begin, pos - begin};
+            m_literal_size   += pos - begin;
+
+            pos   = close + 2;
+            begin = pos;
+        }
+
+        if (arg != arg_count) {
+            _format_error("error: [f-string engine]: format string has fewer placeholders than "
+                          "arguments");
+        }
+
+        m_segments[arg_count] = {begin, size - begin};
+        m_literal_size       += size - begin;
+    }
+
+    LIBCXX_NAMESPACE::string_view m_str;
+    array<Segment, arg_count + 1> m_segments{};
+    array<Spec, arg_count>        m_specs{};
+    usize                         m_literal_size = 0;
+    usize                         m_padding_size = 0;
+};
+
+/// \struct FixedString
+/// A string literal usable as a template argument, `Log::info<"x: \\{\\}">(x)` passes its format
+/// string this way so every call site gets its own instantiation.
+template <usize N>
+struct FixedString {
+    char data[N]{};
+
+    consteval FixedString(const char (&str)[N]) {  // NOLINT(google-explicit-constructor)
+        for (usize i = 0; i < N; ++i) {
+            data[i] = str[i];
+        }
+    }
+
+    [[nodiscard]] constexpr LIBCXX_NAMESPACE::string_view view() const noexcept { return {data, N - 1}; }
+};
+
+template <typename T>
+concept StringLike = H_STD_NAMESPACE::Meta::convertible_to<const T &, LIBCXX_NAMESPACE::string_view>;
+
+/// \brief estimate how many bytes `value` will occupy once formatted.
+///
+/// used to size the output once up front; an underestimate only costs a geometric regrow.
+template <typename T>
+constexpr usize size_hint(const T &value) noexcept {
+    using U = H_STD_NAMESPACE::Meta::remove_cvref_t<T>;
+
+    if constexpr (H_STD_NAMESPACE::Meta::same_as<U, char>) {
+        return 1;
+    } else if constexpr (requires { value.size(); } && StringLike<U>) {
+        return value.size();
+    } else if constexpr (LIBCXX_NAMESPACE::is_arithmetic_v<U>) {
+        return max_chars<U>;
+    } else {
+        return 16;
+    }
+}
+
+/// \brief append the textual form of `value` to `out`.
+///
+/// strings, characters and numbers are written straight in without allocating, `Formattable`
+/// types append themselves, everything else goes through `to_string`.
+template <typename T>
+void write(Buffer &out, T &&value) {
+    using U = H_STD_NAMESPACE::Meta::remove_cvref_t<T>;
+
+    if constexpr (H_STD_NAMESPACE::Meta::same_as<U, H_STD_NAMESPACE::endl>) {
+        out.append(value.get());
+    } else if constexpr (H_STD_NAMESPACE::Meta::same_as<U, char>) {
+        out.push_back(value);
+    } else if constexpr (H_STD_NAMESPACE::Meta::same_as<U, const char *> ||
+                         H_STD_NAMESPACE::Meta::same_as<U, char *>) {
+        if (value != nullptr) {
+            out.append(LIBCXX_NAMESPACE::string_view(value));
+        }
+    } else if constexpr (StringLike<U>) {
+        out.append(LIBCXX_NAMESPACE::string_view(value));
+    } else if constexpr (LIBCXX_NAMESPACE::is_arithmetic_v<U>) {
+        char digits[max_chars<U>];
+        out.append(digits, static_cast<usize>(write_number(digits, static_cast<U>(value)) - digits));
+    } else if constexpr (H_STD_NAMESPACE::Interfaces::Formattable<U>) {
+        if constexpr (requires(const U &v) { v.operator$format(out); }) {
+            static_cast<const U &>(value).operator$format(out);
+        } else {
+            static_cast<const U &>(value).operator$format(Appender(out));
+        }
+    } else {
+        out.append(H_STD_NAMESPACE::to_string(H_STD_NAMESPACE::Memory::forward<T>(value)));
+    }
+}
+
+/// \brief append `value` to `out` as described by `spec`.
+///
+/// numbers and strings are padded and converted in place; other types are formatted into a
+/// temporary first when a width is given, since their length is only known afterwards.
+template <typename T>
+void write(Buffer &out, T &&value, const Spec &spec) {
+    using U = H_STD_NAMESPACE::Meta::remove_cvref_t<T>;
+
+    if (spec.empty()) {
+        Format::write(out, H_STD_NAMESPACE::Memory::forward<T>(value));
+        return;
+    }
+
+    constexpr Kind kind = kind_of<U>();
+
+    if constexpr (kind == Kind::Integer) {
+        write_integer(out, value, spec);
+    } else if constexpr (kind == Kind::Float) {
+        write_floating(out, value, spec);
+    } else if constexpr (kind == Kind::Bool || kind == Kind::Char) {
+        if (spec.type == '\0' || spec.type == 's' || spec.type == 'c') {
+            char  text[5] = {static_cast<char>(value)};
+            usize size    = 1;
+
+            if constexpr (kind == Kind::Bool) {
+                size = static_cast<usize>(write_number(text, value) - text);
+            }
+
+            write_aligned(out, {text, size}, size, spec, Spec::Align::Left);
+        } else {
+            write_integer(out, static_cast<i32>(value), spec);
+        }
+    } else if constexpr (kind == Kind::String) {
+        if constexpr (H_STD_NAMESPACE::Meta::same_as<U, const char *> || H_STD_NAMESPACE::Meta::same_as<U, char *>) {
+            write_string(out, value != nullptr ? LIBCXX_NAMESPACE::string_view(value) : LIBCXX_NAMESPACE::string_view(), spec);
+        } else {
+            write_string(out, LIBCXX_NAMESPACE::string_view(value), spec);
+        }
+    } else {
+        string       text;
+        StringBuffer temp(text);
+        temp.set_element_limit(out.element_limit());
+
+        Format::write(temp, H_STD_NAMESPACE::Memory::forward<T>(value));
+        write_aligned(out, {temp.data(), temp.size()}, text_width({temp.data(), temp.size()}), spec, Spec::Align::Left);
+    }
+}
+
+/// \brief format `args` into `out` according to `fmt`.
+///
+/// each literal segment and argument is appended exactly once, in order; no intermediate
+/// strings are created for string or character arguments.
+template <typename... Args>
+void format_to(Buffer &out, FormatString<H_STD_NAMESPACE::Meta::type_identity_t<Args>...> fmt, Args &&...args) {
+    [&]<usize... I>(LIBCXX_NAMESPACE::integer_sequence<usize, I...>) {
+        ((out.append(fmt.literal(I)), Format::write(out, H_STD_NAMESPACE::Memory::forward<Args>(args), fmt.spec(I))), ...);
+    }(LIBCXX_NAMESPACE::make_integer_sequence<usize, sizeof...(Args)>{});
+
+    out.append(fmt.literal(sizeof...(Args)));
+}
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
@@ -0,0 +1,312 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_MAPPED__
+#define __$LIBHELIX_PRINT_MAPPED__
+
+#include "../config.h"
+#include "../libcxx.h"
+#include "../memory.h"
+#include "../meta.h"
+#include "../primitives.h"
+#include "buffer.h"
+#include "format.h"
+#include "spec.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Format {
+/// \struct Named
+/// An argument to `mapped_format` bound to the name its placeholder uses, made by
+/// `Format::arg<"name">(value)`. Holds a reference, it is only meant to live for the call.
+template <FixedString Name, typename T>
+struct Named {
+    using type = T;
+
+    static constexpr LIBCXX_NAMESPACE::string_view name = Name.view();
+
+    const T &value;
+};
+
+/// bind `value` to the placeholder `{name}`.
+template <FixedString Name, typename T>
+constexpr Named<Name, T> arg(const T &value) noexcept {
+    return {value};
+}
+
+/// \struct Piece
+/// One step of a parsed `mapped_format` template, either literal text or an argument.
+struct Piece {
+    static constexpr usize literal = static_cast<usize>(-1);
+
+    usize offset = 0;
+    usize length = 0;
+    usize arg    = literal;
+    Spec  spec;
+};
+
+/// \brief split a `mapped_format` template into literal text and named fields.
+///
+/// `{name}` and `{name:spec}` are fields, `{{` and `}}` are literal braces. calls
+/// `on_literal(offset, length)` and `on_field(name, spec_text)` in order.
+template <typename OnLiteral, typename OnField>
+constexpr void parse_mapped(LIBCXX_NAMESPACE::string_view text, OnLiteral &&on_literal, OnField &&on_field) {
+    const usize size  = text.size();
+    usize       begin = 0;
+    usize       pos   = 0;
+
+    auto flush = [&](usize end) {
+        if (end != begin) {
+            on_literal(begin, end - begin);
+        }
+    };
+
+    while (pos < size) {
+        if (text[pos] == '}') {
+            if (pos + 1 >= size || text[pos + 1] != '}') {
+                _format_error("error: [f-string engine]: unmatched '}' in format string");
+            }
+
+            flush(pos + 1);  // keep one of the two braces
+            pos  += 2;
+            begin = pos;
+            continue;
+        }
+
+        if (text[pos] != '{') {
+            ++pos;
+            continue;
+        }
+
+        if (pos + 1 < size && text[pos + 1] == '{') {
+            flush(pos + 1);
+            pos  += 2;
+            begin = pos;
+            continue;
+        }
+
+        usize close = pos + 1;
+        usize colon = size;
+
+        while (close < size && text[close] != '}') {
+            if (text[close] == ':' && colon == size) {
+                colon = close;
+            }
+
+            ++close;
+        }
+
+        if (close >= size) {
+            _format_error("error: [f-string engine]: unterminated '{' in format string");
+        }
+
+        const usize name_end = colon < close ? colon : close;
+
+        if (name_end == pos + 1) {
+            _format_error("error: [f-string engine]: placeholder has no argument name");
+        }
+
+        flush(pos);
+        on_field(text.substr(pos + 1, name_end - pos - 1), text.substr(name_end, close - name_end));
+
+        pos   = close + 1;
+        begin = pos;
+    }
+
+    flush(size);
+}
+
+namespace _mapped {
+    template <typename... Named>
+    constexpr usize find_arg(LIBCXX_NAMESPACE::string_view name) {
+        constexpr LIBCXX_NAMESPACE::string_view names[] = {Named::name..., {}};
+
+        for (usize i = 0; i < sizeof...(Named); ++i) {
+            if (names[i] == name) {
+                return i;
+            }
+        }
+
+        _format_error("error: [f-string engine]: placeholder names an argument that was not passed");
+    }
+
+    /// the compiled form of a constant template, built once per template and argument list.
+    template <FixedString Fmt, typename... Named>
+    struct Plan {
+        static consteval usize count() {
+            usize count = 0;
+
+            parse_mapped(
+                Fmt.view(),
+                [&](usize, usize) { ++count; },
+                [&](LIBCXX_NAMESPACE::string_view, LIBCXX_NAMESPACE::string_view) { ++count; });
+
+            return count;
+        }
+
+        static consteval array<Piece, count()> build() {
+            constexpr Kind kinds[] = {kind_of<typename Named::type>()..., Kind::Other};
+
+            array<Piece, count()> pieces{};
+            usize                 idx = 0;
+
+            parse_mapped(
+                Fmt.view(),
+                [&](usize offset, usize length) { pieces[idx++] = {offset, length, Piece::literal, {}}; },
+                [&](LIBCXX_NAMESPACE::string_view name, LIBCXX_NAMESPACE::string_view spec) {
+                    const usize arg = find_arg<Named...>(name);
+                    pieces[idx++]   = {0, 0, arg, parse_spec(spec, kinds[arg])};
+                });
+
+            return pieces;
+        }
+
+        static consteval usize size_estimate() {
+            usize size = 0;
+
+            for (const Piece &piece : pieces) {
+                size += piece.length + piece.spec.width;
+            }
+
+            return size;
+        }
+
+        static constexpr array<Piece, count()> pieces   = build();
+        static constexpr usize                 estimate = size_estimate();
+    };
+}  // namespace _mapped
+
+/// \brief format named arguments into `out` using the constant template `Fmt`.
+///
+/// names are resolved to argument positions while compiling, the generated code is the same
+/// straight sequence of appends and writes a positional `format_to` produces.
+template <FixedString Fmt, typename... Named>
+void mapped_format_to(Buffer &out, const Named &...args) {
+    using Plan = _mapped::Plan<Fmt, Named...>;
+
+    constexpr LIBCXX_NAMESPACE::string_view text = Fmt.view();
+    const auto                              refs = LIBCXX_NAMESPACE::forward_as_tuple(args...);
+
+    [&]<usize... I>(LIBCXX_NAMESPACE::integer_sequence<usize, I...>) {
+        (
+            [&] {
+                constexpr Piece piece = Plan::pieces[I];
+
+                if constexpr (piece.arg == Piece::literal) {
+                    out.append(text.substr(piece.offset, piece.length));
+                } else {
+                    Format::write(out, LIBCXX_NAMESPACE::get<piece.arg>(refs).value, piece.spec);
+                }
+            }(),
+            ...);
+    }(LIBCXX_NAMESPACE::make_integer_sequence<usize, Plan::pieces.size()>{});
+}
+
+/// \class Template
+///
+/// A `mapped_format` template only known at runtime, compiled once and reused.
+///
+/// ```cpp
+/// const Format::Template row(load_template(), {"name", "count"});
+///
+/// for (const auto &entry : entries) {
+///     out += row.format(entry.name, entry.count);
+/// }
+/// ```
+///
+/// ### Design Details
+/// - **Compiled once**: the text is copied and split into pieces in the constructor, every name
+///   is resolved against the parameter list there; unknown names throw.
+/// - **Positional calls**: `format` takes the values in parameter order, so a call never looks
+///   a name up. Each field's specifier is checked against its value's type (a few compares).
+class Template {
+  public:
+    Template(LIBCXX_NAMESPACE::string_view text, LIBCXX_NAMESPACE::initializer_list<LIBCXX_NAMESPACE::string_view> params)
+        : Template(text, params.begin(), params.size()) {}
+
+    Template(LIBCXX_NAMESPACE::string_view text, const LIBCXX_NAMESPACE::string_view *params, usize count)
+        : m_text(text)
+        , m_arity(count) {
+        parse_mapped(
+            m_text,
+            [&](usize offset, usize length) { m_pieces.push_back({offset, length, Piece::literal, {}}); },
+            [&](LIBCXX_NAMESPACE::string_view name, LIBCXX_NAMESPACE::string_view spec) {
+                usize arg = 0;
+
+                while (arg < count && params[arg] != name) {
+                    ++arg;
+                }
+
+                if (arg == count) {
+                    _format_error("error: [f-string engine]: placeholder names an unknown parameter");
+                }
+
+                m_pieces.push_back({0, 0, arg, parse_spec(spec)});
+            });
+
+        for (const Piece &piece : m_pieces) {
+            m_estimate += piece.length + piece.spec.width;
+        }
+    }
+
+    [[nodiscard]] usize arity() const noexcept { return m_arity; }
+
+    /// \brief append the template to `out` with `args` in parameter order.
+    template <typename... Args>
+    void format_to(Buffer &out, const Args &...args) const {
+        if (sizeof...(Args) != m_arity) {
+            _format_error("error: [f-string engine]: template called with the wrong number of arguments");
+        }
+
+        constexpr Kind kinds[] = {kind_of<Args>()..., Kind::Other};
+
+        for (const Piece &piece : m_pieces) {
+            if (piece.arg == Piece::literal) {
+                out.append(LIBCXX_NAMESPACE::string_view(m_text).substr(piece.offset, piece.length));
+                continue;
+            }
+
+            check_spec(piece.spec, kinds[piece.arg]);
+
+            [&]<usize... I>(LIBCXX_NAMESPACE::integer_sequence<usize, I...>) {
+                ((piece.arg == I ? Format::write(out, args, piece.spec) : void()), ...);
+            }(LIBCXX_NAMESPACE::make_integer_sequence<usize, sizeof...(Args)>{});
+        }
+    }
+
+    template <typename... Args>
+    [[nodiscard]] string format(const Args &...args) const {
+        string result;
+
+        {
+            StringBuffer out(result, m_estimate + (size_hint(args) + ... + usize(0)));
+            format_to(out, args...);
+        }
+
+        return result;
+    }
+
+  private:
+    string                          m_text;
+    LIBCXX_NAMESPACE::vector<Piece> m_pieces;
+    usize                           m_arity    = 0;
+    usize                           m_estimate = 0;
+};
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
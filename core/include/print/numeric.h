@@ -0,0 +1,155 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_NUMERIC__
+#define __$LIBHELIX_PRINT_NUMERIC__
+
+#include "../config.h"
+#include "../libcxx.h"
+#include "../meta.h"
+#include "../primitives.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Format {
+namespace _numeric {
+    inline constexpr char digits2[] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+
+    inline constexpr u64 pow10[] = {1ULL,
+                                    10ULL,
+                                    100ULL,
+                                    1000ULL,
+                                    10000ULL,
+                                    100000ULL,
+                                    1000000ULL,
+                                    10000000ULL,
+                                    100000000ULL,
+                                    1000000000ULL,
+                                    10000000000ULL,
+                                    100000000000ULL,
+                                    1000000000000ULL,
+                                    10000000000000ULL,
+                                    100000000000000ULL,
+                                    1000000000000000ULL,
+                                    10000000000000000ULL,
+                                    100000000000000000ULL,
+                                    1000000000000000000ULL,
+                                    10000000000000000000ULL};
+}  // namespace _numeric
+
+/// the largest number of characters `write_number` can produce for a `T`.
+template <typename T>
+inline constexpr usize max_chars = H_STD_NAMESPACE::Meta::same_as<T, bool>     ? 5
+                                   : LIBCXX_NAMESPACE::is_floating_point_v<T> ? 48
+                                   : LIBCXX_NAMESPACE::numeric_limits<T>::digits10 + 2;
+
+/// \brief number of decimal digits in `n`.
+///
+/// the bit width gives log2(n), `* 1233 >> 12` turns that into a floor(log10) estimate that is
+/// off by at most one, a single table compare corrects it. no loop and no division.
+constexpr u32 count_digits(u64 n) noexcept {
+    n |= 1;  // 0 has one digit, and no power of ten is odd so the result is otherwise unchanged
+
+    const u32 t = (static_cast<u32>(LIBCXX_NAMESPACE::bit_width(n)) * 1233) >> 12;
+    return t - static_cast<u32>(n < _numeric::pow10[t]) + 1;
+}
+
+/// \brief write the decimal digits of `n` so that they end at `end`, returns the first digit.
+///
+/// two digits are produced per division using a 200 byte pair table.
+constexpr char *write_digits_backward(char *end, u64 n) noexcept {
+    while (n >= 100) {
+        const usize idx = static_cast<usize>(n % 100) * 2;
+        n /= 100;
+
+        *--end = _numeric::digits2[idx + 1];
+        *--end = _numeric::digits2[idx];
+    }
+
+    if (n < 10) {
+        *--end = static_cast<char>('0' + n);
+    } else {
+        const usize idx = static_cast<usize>(n) * 2;
+
+        *--end = _numeric::digits2[idx + 1];
+        *--end = _numeric::digits2[idx];
+    }
+
+    return end;
+}
+
+/// \brief write an integer into `first`, returns one past the last character.
+///
+/// `first` must have room for `max_chars<T>` characters.
+template <typename T>
+    requires(LIBCXX_NAMESPACE::is_integral_v<T>)
+constexpr char *write_int(char *first, T value) noexcept {
+    u64 abs = static_cast<u64>(value);
+
+    if constexpr (LIBCXX_NAMESPACE::is_signed_v<T>) {
+        if (value < 0) {
+            *first++ = '-';
+            abs      = 0 - abs;
+        }
+    }
+
+    char *end = first + count_digits(abs);
+    write_digits_backward(end, abs);
+
+    return end;
+}
+
+/// \brief write the shortest decimal form of `value` that parses back to the same value.
+///
+/// `first` must have room for `max_chars<T>` characters.
+template <typename T>
+    requires(LIBCXX_NAMESPACE::is_floating_point_v<T>)
+inline char *write_float(char *first, T value) noexcept {
+    return LIBCXX_NAMESPACE::to_chars(first, first + max_chars<T>, value).ptr;
+}
+
+/// \brief write any arithmetic value, `bool` as `true`/`false`.
+///
+/// `first` must have room for `max_chars<T>` characters.
+template <typename T>
+    requires(LIBCXX_NAMESPACE::is_arithmetic_v<T>)
+inline char *write_number(char *first, T value) noexcept {
+    if constexpr (H_STD_NAMESPACE::Meta::same_as<T, bool>) {
+        const char *str = value ? "true" : "false";
+        const usize len = value ? 4 : 5;
+
+        LIBCXX_NAMESPACE::memcpy(first, str, len);
+        return first + len;
+    } else if constexpr (LIBCXX_NAMESPACE::is_floating_point_v<T>) {
+        return write_float(first, value);
+    } else {
+        return write_int(first, value);
+    }
+}
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
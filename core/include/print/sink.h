@@ -0,0 +1,187 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_SINK__
+#define __$LIBHELIX_PRINT_SINK__
+
+#include "../config.h"
+#include "../libc.h"
+#include "../libcxx.h"
+#include "../primitives.h"
+#include "buffer.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Format {
+/// \enum FlushPolicy
+/// When a `Sink` hands its buffered bytes to the operating system.
+///
+/// - `Line`:     after a `print` that wrote a newline, and whenever the buffer is full.
+/// - `Size`:     only when the buffer is full.
+/// - `Explicit`: only on `flush()` (or when the sink is destroyed); the buffer grows instead of
+///               flushing when it runs out of space.
+enum class FlushPolicy : u8 { Line, Size, Explicit };
+
+/// \class Sink
+///
+/// A `Buffer` that drains into a file descriptor. Formatting writes straight into the sink's
+/// storage and the bytes leave the process with one `write(2)` per flush, rather than one stdio
+/// call per argument.
+///
+/// ### Design Details
+/// - **Per-thread**: `stdout_sink()` returns a `thread_local` sink, so `print` never takes a lock
+///   and each flush is a single contiguous write; output from different threads interleaves at
+///   flush granularity.
+/// - **Bounded**: under `Line` and `Size` the storage never grows, a full buffer is flushed and
+///   writing continues from the start.
+/// - **Lifetime**: a sink flushes when destroyed, for the main thread that happens at normal
+///   process exit. Paths that terminate abnormally must call `flush()` first.
+///
+/// ### Notes
+/// - Write errors are not reported. Bytes the descriptor refuses stay buffered and are retried
+///   on the next flush; once the buffer is full of them, new output is dropped, the same way a
+///   stdio stream in an error state drops it.
+class Sink final : public Buffer {
+  public:
+    static constexpr usize default_capacity = 4096;
+
+    explicit Sink(i32 fd, FlushPolicy policy = FlushPolicy::Size, usize capacity = default_capacity)
+        : Buffer(grow)
+        , m_fd(fd)
+        , m_policy(policy) {
+        m_storage.resize(capacity != 0 ? capacity : default_capacity);
+        set(m_storage.data(), m_storage.size());
+    }
+
+    ~Sink() { flush(); }
+
+    Sink(const Sink &)            = delete;
+    Sink(Sink &&)                 = delete;
+    Sink &operator=(const Sink &) = delete;
+    Sink &operator=(Sink &&)      = delete;
+
+    [[nodiscard]] i32         fd() const noexcept { return m_fd; }
+    [[nodiscard]] FlushPolicy policy() const noexcept { return m_policy; }
+
+    void set_policy(FlushPolicy policy) {
+        flush();
+        m_policy = policy;
+    }
+
+    /// change the size of the buffer, pending output is flushed first.
+    void set_capacity(usize capacity) {
+        flush();
+        m_storage.resize(capacity != 0 ? capacity : default_capacity);
+        m_storage.shrink_to_fit();
+        set(m_storage.data(), m_storage.size());
+    }
+
+    /// hand every buffered byte to the descriptor. an interrupted write is retried; when the
+    /// descriptor fails, the bytes it did not take stay at the front of the buffer.
+    void flush() {
+        const char *data = this->data();
+        usize       left = size();
+
+        while (left != 0) {
+#ifdef _MSC_VER
+            const isize written = libc::_write(m_fd, data, static_cast<u32>(left));
+#else
+            const isize written = libc::write(m_fd, data, left);
+#endif
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+
+            if (written <= 0) {
+                break;
+            }
+
+            data += written;
+            left -= static_cast<usize>(written);
+        }
+
+        if (left != 0 && data != this->data()) {
+            LIBCXX_NAMESPACE::memmove(this->data(), data, left);
+        }
+
+        resize(left);
+        m_scanned = 0;
+    }
+
+    /// called once at the end of every `print`, applies the flush policy.
+    void commit() {
+        if (m_policy == FlushPolicy::Line && size() != m_scanned) {
+            if (LIBCXX_NAMESPACE::memchr(data() + m_scanned, '\n', size() - m_scanned) != nullptr) {
+                flush();
+                return;
+            }
+        }
+
+        m_scanned = size();
+    }
+
+  private:
+    static void grow(Buffer &buf, usize requested) {
+        auto &self = static_cast<Sink &>(buf);
+
+        if (self.m_policy != FlushPolicy::Explicit) {
+            self.flush();
+            return;
+        }
+
+        usize capacity = self.capacity() * 2;
+        if (capacity < requested) {
+            capacity = requested;
+        }
+
+        self.m_storage.resize(capacity);
+        self.set(self.m_storage.data(), capacity);
+    }
+
+    string      m_storage;
+    usize       m_scanned = 0;
+    i32         m_fd;
+    FlushPolicy m_policy;
+};
+
+/// \struct StreamOptions
+/// Where and how `std::stream` writes a value.
+///
+/// - `fd`:           destination file descriptor, standard output by default.
+/// - `max_elements`: containers write at most this many elements (per level) and then
+///                   `, ... (N more)`.
+/// - `buffer_size`:  the fixed buffer the output goes through, the peak memory of the call.
+struct StreamOptions {
+    i32   fd           = 1;
+    usize max_elements = Buffer::unlimited;
+    usize buffer_size  = 64 * 1024;
+};
+
+/// the calling thread's sink for standard output. it is line flushed when stdout is a terminal
+/// and size flushed otherwise, matching what stdio does for `stdout`.
+inline Sink &stdout_sink() {
+#ifdef _MSC_VER
+    thread_local Sink sink(1, libc::_isatty(1) ? FlushPolicy::Line : FlushPolicy::Size);
+#else
+    thread_local Sink sink(1, libc::isatty(1) ? FlushPolicy::Line : FlushPolicy::Size);
+#endif
+    return sink;
+}
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
@@ -0,0 +1,512 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_PRINT_SPEC__
+#define __$LIBHELIX_PRINT_SPEC__
+
+#include "../config.h"
+#include "../libcxx.h"
+#include "../meta.h"
+#include "../primitives.h"
+#include "buffer.h"
+#include "numeric.h"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Format {
+/// reports a malformed format string. during constant evaluation the call itself is the error
+/// (this function is not `constexpr`), so the diagnostic points at the offending `stringf` call
+/// with the message as its argument; at runtime it throws.
+[[noreturn]] inline void _format_error(const char *msg) {
+    throw LIBCXX_NAMESPACE::runtime_error(msg);
+}
+
+/// what kind of value a placeholder formats, decides which specifiers it accepts.
+enum class Kind : u8 { Bool, Char, Integer, Float, String, Other };
+
+template <typename T>
+consteval Kind kind_of() {
+    using U = H_STD_NAMESPACE::Meta::remove_cvref_t<T>;
+
+    if constexpr (H_STD_NAMESPACE::Meta::same_as<U, bool>) {
+        return Kind::Bool;
+    } else if constexpr (H_STD_NAMESPACE::Meta::same_as<U, char>) {
+        return Kind::Char;
+    } else if constexpr (LIBCXX_NAMESPACE::is_integral_v<U>) {
+        return Kind::Integer;
+    } else if constexpr (LIBCXX_NAMESPACE::is_floating_point_v<U>) {
+        return Kind::Float;
+    } else if constexpr (H_STD_NAMESPACE::Meta::convertible_to<const U &, LIBCXX_NAMESPACE::string_view> ||
+                         H_STD_NAMESPACE::Meta::same_as<U, const char *> ||
+                         H_STD_NAMESPACE::Meta::same_as<U, char *>) {
+        return Kind::String;
+    } else {
+        return Kind::Other;
+    }
+}
+
+/// \struct Spec
+///
+/// A parsed format specifier, the part after the `:` in `\{:>8\}`.
+///
+/// ### Syntax
+/// `:[[fill]align][sign][#][0][width][.precision][type]`
+///
+/// - **fill / align**: any ascii character followed by `<` (left), `>` (right) or `^` (center).
+/// - **sign**: `+` always prints a sign, ` ` prints a space for non-negative numbers.
+/// - **#**: adds the `0x`, `0b` or `0` radix prefix.
+/// - **0**: pads numbers with zeros after the sign and prefix.
+/// - **precision**: digits after the point for floats, maximum characters for strings.
+/// - **type**: `d x X b B o c` for integers, `e E f F g G` for floats, `s` for strings.
+///
+/// Width and precision count characters (utf-8 code points), not bytes.
+struct Spec {
+    enum class Align : u8 { None, Left, Right, Center };
+    enum class Sign : u8 { Minus, Plus, Space };
+
+    u32   width     = 0;
+    i32   precision = -1;
+    char  fill      = ' ';
+    char  type      = '\0';
+    Align align     = Align::None;
+    Sign  sign      = Sign::Minus;
+    bool  alternate = false;
+    bool  zero      = false;
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return width == 0 && precision < 0 && type == '\0' && sign == Sign::Minus && !alternate;
+    }
+};
+
+namespace _spec {
+    constexpr bool is_integer_type(char type) noexcept {
+        return type == 'd' || type == 'x' || type == 'X' || type == 'b' || type == 'B' || type == 'o';
+    }
+
+    constexpr bool is_float_type(char type) noexcept {
+        return type == 'e' || type == 'E' || type == 'f' || type == 'F' || type == 'g' || type == 'G';
+    }
+
+    constexpr u32 parse_number(LIBCXX_NAMESPACE::string_view text, usize &pos) {
+        u32 value = 0;
+
+        while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+            value = value * 10 + static_cast<u32>(text[pos++] - '0');
+
+            if (value > 0xFFFF) {
+                _format_error("error: [f-string engine]: width or precision is too large");
+            }
+        }
+
+        return value;
+    }
+}  // namespace _spec
+
+/// \brief parse a specifier, `text` is empty or starts with the `:`.
+///
+/// only checks the syntax, see `check_spec` for whether it applies to an argument.
+constexpr Spec parse_spec(LIBCXX_NAMESPACE::string_view text) {
+    Spec spec;
+
+    if (text.empty()) {
+        return spec;
+    }
+
+    if (text[0] != ':') {
+        _format_error("error: [f-string engine]: expected ':' before a format specifier");
+    }
+
+    usize pos = 1;
+
+    auto align_of = [](char chr) {
+        switch (chr) {
+            case '<':
+                return Spec::Align::Left;
+            case '>':
+                return Spec::Align::Right;
+            case '^':
+                return Spec::Align::Center;
+            default:
+                return Spec::Align::None;
+        }
+    };
+
+    if (pos + 1 < text.size() && align_of(text[pos + 1]) != Spec::Align::None) {
+        if (static_cast<unsigned char>(text[pos]) >= 0x80) {
+            _format_error("error: [f-string engine]: fill must be a single ascii character");
+        }
+
+        spec.fill  = text[pos];
+        spec.align = align_of(text[pos + 1]);
+        pos       += 2;
+    } else if (pos < text.size() && align_of(text[pos]) != Spec::Align::None) {
+        spec.align = align_of(text[pos++]);
+    }
+
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-' || text[pos] == ' ')) {
+        spec.sign = text[pos] == '+' ? Spec::Sign::Plus : text[pos] == ' ' ? Spec::Sign::Space : Spec::Sign::Minus;
+        ++pos;
+    }
+
+    if (pos < text.size() && text[pos] == '#') {
+        spec.alternate = true;
+        ++pos;
+    }
+
+    if (pos < text.size() && text[pos] == '0') {
+        spec.zero = true;
+        ++pos;
+    }
+
+    spec.width = _spec::parse_number(text, pos);
+
+    if (pos < text.size() && text[pos] == '.') {
+        const usize start = ++pos;
+        spec.precision    = static_cast<i32>(_spec::parse_number(text, pos));
+
+        if (pos == start) {
+            _format_error("error: [f-string engine]: expected digits after '.' in format specifier");
+        }
+    }
+
+    if (pos < text.size()) {
+        spec.type = text[pos++];
+    }
+
+    if (pos != text.size()) {
+        _format_error("error: [f-string engine]: invalid format specifier");
+    }
+
+    return spec;
+}
+
+/// \brief reject a specifier that does not apply to an argument of kind `kind` (a precision on
+/// an integer, `x` on a string, ...).
+constexpr void check_spec(const Spec &spec, Kind kind) {
+    const bool numeric = spec.sign != Spec::Sign::Minus || spec.alternate || spec.zero;
+
+    switch (kind) {
+        case Kind::Bool:
+        case Kind::Char:
+        case Kind::Integer: {
+            const char text_type = kind == Kind::Bool ? 's' : 'c';
+
+            if (spec.type != '\0' && spec.type != text_type && !_spec::is_integer_type(spec.type)) {
+                _format_error("error: [f-string engine]: invalid presentation type for an integer");
+            }
+
+            if (numeric && (spec.type == text_type || (spec.type == '\0' && kind != Kind::Integer))) {
+                _format_error("error: [f-string engine]: sign, '#' and '0' need a numeric "
+                              "presentation type");
+            }
+
+            if (spec.precision >= 0) {
+                _format_error("error: [f-string engine]: precision is not allowed for integers");
+            }
+            break;
+        }
+
+        case Kind::Float:
+            if (spec.type != '\0' && !_spec::is_float_type(spec.type)) {
+                _format_error("error: [f-string engine]: invalid presentation type for a float");
+            }
+
+            if (spec.alternate) {
+                _format_error("error: [f-string engine]: '#' is not allowed for floats");
+            }
+            break;
+
+        case Kind::String:
+            if (spec.type != '\0' && spec.type != 's') {
+                _format_error("error: [f-string engine]: invalid presentation type for a string");
+            }
+
+            if (numeric) {
+                _format_error("error: [f-string engine]: sign, '#' and '0' are not allowed for strings");
+            }
+            break;
+
+        case Kind::Other:
+            if ((spec.type != '\0' && spec.type != 's') || numeric || spec.precision >= 0) {
+                _format_error("error: [f-string engine]: only fill, alignment and width apply to "
+                              "this type");
+            }
+            break;
+    }
+}
+
+/// \brief parse the text between `\{` and `\}` for an argument of kind `kind`.
+///
+/// an empty text is the plain placeholder; errors are reported at compile time for constant
+/// format strings.
+constexpr Spec parse_spec(LIBCXX_NAMESPACE::string_view text, Kind kind) {
+    const Spec spec = parse_spec(text);
+    check_spec(spec, kind);
+
+    return spec;
+}
+
+/// number of utf-8 code points in `text`.
+inline usize text_width(LIBCXX_NAMESPACE::string_view text) noexcept {
+    usize width = 0;
+
+    for (const char chr : text) {
+        width += static_cast<usize>((static_cast<unsigned char>(chr) & 0xC0) != 0x80);
+    }
+
+    return width;
+}
+
+/// \brief append `body`, padded with `spec.fill` to `spec.width`.
+///
+/// `width` is the display width of `body`, `fallback` the alignment used when the spec has none.
+inline void write_aligned(Buffer                       &out,
+                          LIBCXX_NAMESPACE::string_view body,
+                          usize                         width,
+                          const Spec                   &spec,
+                          Spec::Align                   fallback) {
+    const usize pad   = spec.width > width ? spec.width - width : 0;
+    const auto  align = spec.align == Spec::Align::None ? fallback : spec.align;
+
+    const usize before = align == Spec::Align::Right    ? pad
+                         : align == Spec::Align::Center ? pad / 2
+                                                        : 0;
+
+    out.fill(spec.fill, before);
+    out.append(body);
+    out.fill(spec.fill, pad - before);
+}
+
+/// \brief append a string, truncated to `spec.precision` characters and padded to `spec.width`.
+inline void write_string(Buffer &out, LIBCXX_NAMESPACE::string_view text, const Spec &spec) {
+    if (spec.precision >= 0) {
+        usize count = 0;
+        usize end   = 0;
+
+        for (; end < text.size(); ++end) {
+            if ((static_cast<unsigned char>(text[end]) & 0xC0) != 0x80 &&
+                count++ == static_cast<usize>(spec.precision)) {
+                break;
+            }
+        }
+
+        text = text.substr(0, end);
+    }
+
+    write_aligned(out, text, text_width(text), spec, Spec::Align::Left);
+}
+
+/// \brief append a number as `prefix` followed by `digits`.
+///
+/// with the `0` flag and no explicit alignment, zeros go between the prefix and the digits.
+inline void write_numeric(Buffer                       &out,
+                          LIBCXX_NAMESPACE::string_view prefix,
+                          LIBCXX_NAMESPACE::string_view digits,
+                          const Spec                   &spec,
+                          bool                          zero) {
+    const usize width = prefix.size() + digits.size();
+
+    if (zero && spec.align == Spec::Align::None) {
+        out.append(prefix);
+        out.fill('0', spec.width > width ? spec.width - width : 0);
+        out.append(digits);
+        return;
+    }
+
+    if (spec.width <= width) {
+        out.append(prefix);
+        out.append(digits);
+        return;
+    }
+
+    char joined[96];
+
+    if (width <= sizeof(joined)) {
+        LIBCXX_NAMESPACE::memcpy(joined, prefix.data(), prefix.size());
+        LIBCXX_NAMESPACE::memcpy(joined + prefix.size(), digits.data(), digits.size());
+
+        write_aligned(out, {joined, width}, width, spec, Spec::Align::Right);
+        return;
+    }
+
+    LIBCXX_NAMESPACE::string long_number;
+    long_number.reserve(width);
+    long_number.append(prefix).append(digits);
+
+    write_aligned(out, long_number, width, spec, Spec::Align::Right);
+}
+
+namespace _spec {
+    inline void to_upper(char *first, char *last) noexcept {
+        for (; first != last; ++first) {
+            if (*first >= 'a' && *first <= 'z') {
+                *first = static_cast<char>(*first - 'a' + 'A');
+            }
+        }
+    }
+
+    inline char *sign_prefix(char *prefix, bool negative, Spec::Sign sign) noexcept {
+        if (negative) {
+            *prefix++ = '-';
+        } else if (sign == Spec::Sign::Plus) {
+            *prefix++ = '+';
+        } else if (sign == Spec::Sign::Space) {
+            *prefix++ = ' ';
+        }
+
+        return prefix;
+    }
+}  // namespace _spec
+
+/// \brief append an integer in the radix chosen by `spec.type`.
+template <typename T>
+    requires(LIBCXX_NAMESPACE::is_integral_v<T>)
+void write_integer(Buffer &out, T value, const Spec &spec) {
+    if (spec.type == 'c') {
+        const char chr = static_cast<char>(value);
+        write_aligned(out, {&chr, 1}, 1, spec, Spec::Align::Left);
+        return;
+    }
+
+    bool negative  = false;
+    u64  magnitude = static_cast<u64>(value);
+
+    if constexpr (LIBCXX_NAMESPACE::is_signed_v<T>) {
+        if (value < 0) {
+            negative  = true;
+            magnitude = 0 - magnitude;
+        }
+    }
+
+    char  prefix[4];
+    char *prefix_end = _spec::sign_prefix(prefix, negative, spec.sign);
+
+    int base = 10;
+    switch (spec.type) {
+        case 'x':
+        case 'X':
+            base = 16;
+            break;
+        case 'b':
+        case 'B':
+            base = 2;
+            break;
+        case 'o':
+            base = 8;
+            break;
+        default:
+            break;
+    }
+
+    if (spec.alternate && base != 10 && !(base == 8 && magnitude == 0)) {
+        *prefix_end++ = '0';
+
+        if (base != 8) {
+            *prefix_end++ = spec.type;
+        }
+    }
+
+    char  digits[64];
+    char *digits_end;
+
+    if (base == 10) {
+        digits_end = digits + count_digits(magnitude);
+        write_digits_backward(digits_end, magnitude);
+    } else {
+        digits_end = LIBCXX_NAMESPACE::to_chars(digits, digits + sizeof(digits), magnitude, base).ptr;
+
+        if (spec.type == 'X') {
+            _spec::to_upper(digits, digits_end);
+        }
+    }
+
+    write_numeric(out,
+                  {prefix, static_cast<usize>(prefix_end - prefix)},
+                  {digits, static_cast<usize>(digits_end - digits)},
+                  spec,
+                  spec.zero);
+}
+
+/// \brief append a float in the notation chosen by `spec.type`, `spec.precision` digits.
+template <typename T>
+    requires(LIBCXX_NAMESPACE::is_floating_point_v<T>)
+void write_floating(Buffer &out, T value, const Spec &spec) {
+    const bool negative  = LIBCXX_NAMESPACE::signbit(value);
+    const T    magnitude = negative ? -value : value;
+
+    char  prefix[2];
+    char *prefix_end = _spec::sign_prefix(prefix, negative, spec.sign);
+
+    LIBCXX_NAMESPACE::chars_format format    = LIBCXX_NAMESPACE::chars_format::general;
+    int                            precision = spec.precision;
+
+    switch (spec.type) {
+        case 'e':
+        case 'E':
+            format = LIBCXX_NAMESPACE::chars_format::scientific;
+            break;
+        case 'f':
+        case 'F':
+            format = LIBCXX_NAMESPACE::chars_format::fixed;
+            break;
+        default:
+            break;
+    }
+
+    if (precision < 0 && spec.type != '\0') {
+        precision = 6;
+    }
+
+    auto convert = [&](char *first, char *last) {
+        return precision < 0 ? LIBCXX_NAMESPACE::to_chars(first, last, magnitude)
+                             : LIBCXX_NAMESPACE::to_chars(first, last, magnitude, format, precision);
+    };
+
+    const bool upper = spec.type == 'E' || spec.type == 'F' || spec.type == 'G';
+    const bool zero  = spec.zero && LIBCXX_NAMESPACE::isfinite(value);
+    const auto sign  = LIBCXX_NAMESPACE::string_view(prefix, static_cast<usize>(prefix_end - prefix));
+
+    char digits[128];
+    auto result = convert(digits, digits + sizeof(digits));
+
+    if (result.ec == LIBCXX_NAMESPACE::errc()) {
+        if (upper) {
+            _spec::to_upper(digits, result.ptr);
+        }
+
+        write_numeric(out, sign, {digits, static_cast<usize>(result.ptr - digits)}, spec, zero);
+        return;
+    }
+
+    // fixed notation of a huge value or a huge precision, the only case that allocates
+    LIBCXX_NAMESPACE::string long_digits(LIBCXX_NAMESPACE::numeric_limits<T>::max_exponent10 + 8 +
+                                             static_cast<usize>(precision),
+                                         '\0');
+
+    result = convert(long_digits.data(), long_digits.data() + long_digits.size());
+    long_digits.resize(static_cast<usize>(result.ptr - long_digits.data()));
+
+    if (upper) {
+        _spec::to_upper(long_digits.data(), long_digits.data() + long_digits.size());
+    }
+
+    write_numeric(out, sign, long_digits, spec, zero);
+}
+}  // namespace Format
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+#endif
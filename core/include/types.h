@@ -20,6 +20,8 @@
 #include "libcxx.h"
 #include "memory.h"
 #include "primitives.h"
+#include "print/buffer.h"
+#include "print/numeric.h"
 
 H_NAMESPACE_BEGIN
 
@@ -30,6 +32,26 @@ H_STD_NAMESPACE_BEGIN
 template <typename T>
 constexpr string to_string(T &&t);  // forward declaration
 
+namespace Format {
+template <typename T>
+void write(Buffer &out, T &&value);  // forward declaration
+
+/// closes a container cut short by `Buffer::element_limit` after `written` elements,
+/// `remaining` elements were left out.
+inline void write_elided(Buffer &out, usize written, usize remaining) {
+    char  digits[max_chars<usize>];
+    char *end = write_int(digits, remaining);
+
+    if (written != 0) {
+        out.append(", ", 2);
+    }
+
+    out.append("... (", 5);
+    out.append(digits, static_cast<usize>(end - digits));
+    out.append(" more)", 6);
+}
+}  // namespace Format
+
 H_STD_NAMESPACE_END
 
 template <typename T, usize N>
@@ -44,21 +66,27 @@ class tuple : public LIBCXX_NAMESPACE::tuple<T...> {
     tuple(Ts &&...args) // NOLINT
         : LIBCXX_NAMESPACE::tuple<T...>(H_STD_NAMESPACE::Memory::forward<Ts>(args)...) {}
 
-    inline auto operator$cast(string * /* unused */) -> string {  // cast to string op to allow for printing
-        string result = "(";
+    inline void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const {  // format op to allow for printing
+        out.push_back('(');
 
-        for (usize i = 0; i < sizeof...(T); i++) {
-            result += H_STD_NAMESPACE::to_string(LIBCXX_NAMESPACE::get<i>(*this));
+        [&]<usize... I>(LIBCXX_NAMESPACE::integer_sequence<usize, I...>) {
+            ((I == 0 ? void() : out.append(", ", 2), H_STD_NAMESPACE::Format::write(out, LIBCXX_NAMESPACE::get<I>(*this))), ...);
+        }(LIBCXX_NAMESPACE::make_integer_sequence<usize, sizeof...(T)>{});
 
-            if (i < sizeof...(T) - 1) {
-                result += ", ";
-            }
+        out.push_back(')');
+    }
+
+    inline auto operator$cast(string * /* unused */) const -> string {  // cast to string op to allow for printing
+        string result;
+        {
+            H_STD_NAMESPACE::Format::StringBuffer out(result);
+            operator$format(out);
         }
 
-        return result + ")";
+        return result;
     }
 
-    explicit operator string() { return operator$cast(static_cast<string *>(nullptr)); }
+    explicit operator string() const { return operator$cast(static_cast<string *>(nullptr)); }
 };
 
 template <typename T>
@@ -69,21 +97,38 @@ class list : public LIBCXX_NAMESPACE::vector<T> {
     list(LIBCXX_NAMESPACE::initializer_list<T> init)
         : LIBCXX_NAMESPACE::vector<T>(init) {}
 
-    inline auto operator$cast(string * /* unused */) -> string {  // cast to string op to allow for printing
-        string result = "[";
+    inline void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const {  // format op to allow for printing
+        out.push_back('[');
+
+        usize count = 0;
 
-        for (usize i = 0; i < this->size(); i++) {
-            result += H_STD_NAMESPACE::to_string(this->at(i));
+        for (auto it = this->begin(); it != this->end(); ++it) {
+            if (count == out.element_limit()) {
+                H_STD_NAMESPACE::Format::write_elided(out, count, this->size() - count);
+                break;
+            }
 
-            if (i < this->size() - 1) {
-                result += ", ";
+            if (count++ != 0) {
+                out.append(", ", 2);
             }
+
+            H_STD_NAMESPACE::Format::write(out, *it);
+        }
+
+        out.push_back(']');
+    }
+
+    inline auto operator$cast(string * /* unused */) const -> string {  // cast to string op to allow for printing
+        string result;
+        {
+            H_STD_NAMESPACE::Format::StringBuffer out(result);
+            operator$format(out);
         }
 
-        return result + "]";
+        return result;
     }
 
-    explicit operator string() { return operator$cast(static_cast<string *>(nullptr)); }
+    explicit operator string() const { return operator$cast(static_cast<string *>(nullptr)); }
 };
 
 template <typename T>
@@ -94,21 +139,38 @@ class set : public LIBCXX_NAMESPACE::set<T> {
     set(LIBCXX_NAMESPACE::initializer_list<T> init)
         : LIBCXX_NAMESPACE::set<T>(init) {}
 
-    inline auto operator$cast(string * /* unused */) -> string {  // cast to string op to allow for printing
-        string result = "{";
+    inline void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const {  // format op to allow for printing
+        out.push_back('{');
+
+        usize count = 0;
 
-        for (auto it = this->begin(); it != this->end(); it++) {
-            result += H_STD_NAMESPACE::to_string(*it);
+        for (auto it = this->begin(); it != this->end(); ++it) {
+            if (count == out.element_limit()) {
+                H_STD_NAMESPACE::Format::write_elided(out, count, this->size() - count);
+                break;
+            }
 
-            if (LIBCXX_NAMESPACE::next(it) != this->end()) {
-                result += ", ";
+            if (count++ != 0) {
+                out.append(", ", 2);
             }
+
+            H_STD_NAMESPACE::Format::write(out, *it);
+        }
+
+        out.push_back('}');
+    }
+
+    inline auto operator$cast(string * /* unused */) const -> string {  // cast to string op to allow for printing
+        string result;
+        {
+            H_STD_NAMESPACE::Format::StringBuffer out(result);
+            operator$format(out);
         }
 
-        return result + "}";
+        return result;
     }
 
-    explicit operator string() { return operator$cast(static_cast<string *>(nullptr)); }
+    explicit operator string() const { return operator$cast(static_cast<string *>(nullptr)); }
 };
 
 template <typename K, typename V>
@@ -119,21 +181,40 @@ class map : public LIBCXX_NAMESPACE::map<K, V> {
     map(LIBCXX_NAMESPACE::initializer_list<LIBCXX_NAMESPACE::pair<const K, V>> init)
         : LIBCXX_NAMESPACE::map<K, V>(init) {}
 
-    inline auto operator$cast(string * /* unused */) -> string {  // cast to string op to allow for printing
-        string result = "{";
+    inline void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const {  // format op to allow for printing
+        out.push_back('{');
 
-        for (auto it = this->begin(); it != this->end(); it++) {
-            result += H_STD_NAMESPACE::to_string(it->first) + ": " + H_STD_NAMESPACE::to_string(it->second);
+        usize count = 0;
 
-            if (LIBCXX_NAMESPACE::next(it) != this->end()) {
-                result += ", ";
+        for (auto it = this->begin(); it != this->end(); ++it) {
+            if (count == out.element_limit()) {
+                H_STD_NAMESPACE::Format::write_elided(out, count, this->size() - count);
+                break;
             }
+
+            if (count++ != 0) {
+                out.append(", ", 2);
+            }
+
+            H_STD_NAMESPACE::Format::write(out, it->first);
+            out.append(": ", 2);
+            H_STD_NAMESPACE::Format::write(out, it->second);
+        }
+
+        out.push_back('}');
+    }
+
+    inline auto operator$cast(string * /* unused */) const -> string {  // cast to string op to allow for printing
+        string result;
+        {
+            H_STD_NAMESPACE::Format::StringBuffer out(result);
+            operator$format(out);
         }
 
-        return result + "}";
+        return result;
     }
 
-    explicit operator string() { return operator$cast(static_cast<string *>(nullptr)); }
+    explicit operator string() const { return operator$cast(static_cast<string *>(nullptr)); }
 };
 
 H_NAMESPACE_END
@@ -39,6 +39,9 @@
 #include "../memory.h"
 #include "../meta.h"
 #include "../primitives.h"
+#include "../print/buffer.h"
+#include "../types/errors.h"
+#include "string/search.hh"
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -76,17 +79,129 @@ concept CharaterCompliance = requires(self inst, self other, char c, int i) {
 H_STD_NAMESPACE_END
 
 namespace String {
-/// \class string_slice
-/// \brief A string slice is a view into a string, it does not own the data, this can also be set
-///        to read-only char pointers
-/// \tparam _ElemT The element type of the string
-/// \tparam _Size The size of the string slice (this is not the size of the string but the size of
-///         the slice itself like a substring)
+namespace _string {
+    template <typename CharT>
+    inline constexpr bool has_traits = std::Meta::same_as<CharT, char> || std::Meta::same_as<CharT, wchar_t> ||
+                                       std::Meta::same_as<CharT, char8_t> || std::Meta::same_as<CharT, char16_t> ||
+                                       std::Meta::same_as<CharT, char32_t>;
+
+    /// one byte character types go through the vector kernels in `string/search.hh` (outside
+    /// constant evaluation, where the plain algorithms are used).
+    template <typename CharT>
+    inline constexpr bool is_byte = sizeof(CharT) == 1 && LIBCXX_NAMESPACE::is_integral_v<CharT>;
+
+    /// three way compare of `count` characters, `memcmp` (or `wmemcmp`) for the standard
+    /// character types and a plain loop otherwise.
+    template <typename CharT>
+    constexpr int compare(const CharT *lhs, const CharT *rhs, usize count) noexcept {
+        if (count == 0) {
+            return 0;
+        }
+
+        if constexpr (has_traits<CharT>) {
+            return LIBCXX_NAMESPACE::char_traits<CharT>::compare(lhs, rhs, count);
+        } else {
+            for (usize i = 0; i < count; ++i) {
+                if (lhs[i] != rhs[i]) {
+                    return lhs[i] < rhs[i] ? -1 : 1;
+                }
+            }
+
+            return 0;
+        }
+    }
+
+    /// the length of the text in a character array: up to its first null character and never
+    /// past the end of the array.
+    template <typename CharT, usize N>
+    constexpr usize array_length(const CharT (&array)[N]) noexcept {
+        usize size = 0;
+
+        while (size != N && array[size] != CharT()) {
+            ++size;
+        }
+
+        return size;
+    }
+
+    struct literal_tag {};
+}  // namespace _string
+
+/// \class literal
+///
+/// Text the compiler placed in read-only storage for the life of the program. Strings that are
+/// handed a `literal` reference it in place instead of copying it (`basic`'s ROM storage,
+/// `shared`, `rope::append`); a character array alone cannot promise that, it may be a buffer on
+/// the stack or one that is written later, so arrays are always copied.
+///
+/// A `literal` only comes from a string literal: the `_s` suffix (`"text"_s`, in
+/// `String::literals`), or the array constructor in a constant expression, which accepts string
+/// literals and `constexpr` arrays with static storage.
+///
+/// \tparam CharT The element type of the string
 template <typename CharT>
-class slice {
+class literal {
+  public:
+    template <usize N>
+    consteval literal(const CharT (&text)[N]) noexcept  // NOLINT(google-explicit-constructor)
+        : m_data(text)
+        , m_size(_string::array_length(text)) {}
+
+    /// used by the `_s` suffix, which is only ever applied to a string literal.
+    constexpr literal(_string::literal_tag, const CharT *data, usize size) noexcept
+        : m_data(data)
+        , m_size(size) {}
+
+    [[nodiscard]] constexpr const CharT *data() const noexcept { return m_data; }
+    [[nodiscard]] constexpr usize        size() const noexcept { return m_size; }
+
   private:
-    mutable helix::$generator<CharT> $gen_state = operator$generator();
+    const CharT *m_data;
+    usize        m_size;
+};
 
+inline namespace literals {
+    constexpr literal<char> operator""_s(const char *text, LIBCXX_NAMESPACE::size_t size) noexcept {
+        return {_string::literal_tag{}, text, size};
+    }
+
+    constexpr literal<wchar_t> operator""_s(const wchar_t *text, LIBCXX_NAMESPACE::size_t size) noexcept {
+        return {_string::literal_tag{}, text, size};
+    }
+
+    constexpr literal<char8_t> operator""_s(const char8_t *text, LIBCXX_NAMESPACE::size_t size) noexcept {
+        return {_string::literal_tag{}, text, size};
+    }
+
+    constexpr literal<char16_t> operator""_s(const char16_t *text, LIBCXX_NAMESPACE::size_t size) noexcept {
+        return {_string::literal_tag{}, text, size};
+    }
+
+    constexpr literal<char32_t> operator""_s(const char32_t *text, LIBCXX_NAMESPACE::size_t size) noexcept {
+        return {_string::literal_tag{}, text, size};
+    }
+}  // namespace literals
+
+/// \class slice
+///
+/// A view into characters owned by someone else, a pointer and a length. It never allocates and
+/// never owns, so it is as cheap to pass around as a pointer; the viewed characters must outlive
+/// it.
+///
+/// ### Design Details
+/// - **Contiguous iterators**: `begin()`/`end()` are plain `const CharT *`, usable with every
+///   standard algorithm and trivially vectorizable loops.
+/// - **Comparisons**: equality checks the sizes and then one `memcmp`, ordering is a single
+///   `memcmp` over the common prefix (`wmemcmp` and friends for the wider character types).
+/// - **Generators**: `iter()` still hands out a `$generator` for helix code that wants one, the
+///   coroutine frame is only created when it is asked for.
+/// - **Interop**: a `std::basic_string` (`helix::string`) or `std::basic_string_view` converts to a
+///   slice of its buffer and a slice converts back to a `string_view`, neither copies. The
+///   conversions take the exact standard types, so nothing converts through them by accident.
+///
+/// \tparam CharT The element type of the string
+template <typename CharT>
+class slice {
   public:
     using value_type      = CharT;
     using size_type       = usize;
@@ -98,85 +213,1093 @@ class slice {
     using pointer       = const CharT *;
     using const_pointer = const CharT *;
 
-    constexpr slice() noexcept;
-    constexpr slice(const CharT *data, size_type size) noexcept;
+    using iterator               = const CharT *;
+    using const_iterator         = const CharT *;
+    using reverse_iterator       = LIBCXX_NAMESPACE::reverse_iterator<const_iterator>;
+    using const_reverse_iterator = LIBCXX_NAMESPACE::reverse_iterator<const_iterator>;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    constexpr slice() noexcept = default;
+    constexpr slice(const CharT *data, size_type size) noexcept
+        : m_data(data)
+        , m_size(size) {}
+
+    template <typename Traits>
+    constexpr slice(LIBCXX_NAMESPACE::basic_string_view<CharT, Traits> view) noexcept  // NOLINT(google-explicit-constructor)
+        : m_data(view.data())
+        , m_size(view.size()) {}
+
+    /// views the string's buffer, which must outlive the slice; any change to the string's size
+    /// may move the buffer.
+    template <typename Traits, typename Alloc>
+    constexpr slice(const LIBCXX_NAMESPACE::basic_string<CharT, Traits, Alloc> &str) noexcept  // NOLINT(google-explicit-constructor)
+        : m_data(str.data())
+        , m_size(str.size()) {}
+
     constexpr slice(const slice &) noexcept = default;
     constexpr slice(slice &&) noexcept      = default;
 
     constexpr slice &operator=(const slice &) noexcept = default;
     constexpr slice &operator=(slice &&) noexcept      = default;
 
-    constexpr reference operator[](size_type pos) const noexcept;
-    constexpr reference at(size_type pos) const;
-    constexpr reference front() const noexcept;
-    constexpr reference back() const noexcept;
-    constexpr pointer   data() const noexcept;
+    constexpr reference operator[](size_type pos) const noexcept { return m_data[pos]; }
 
-    [[nodiscard]] constexpr bool      empty() const noexcept;
-    [[nodiscard]] constexpr size_type size() const noexcept;
-    [[nodiscard]] constexpr size_type length() const noexcept;
+    constexpr reference at(size_type pos) const {
+        if (pos >= m_size) {
+            throw H_STD_NAMESPACE::errors::RuntimeError("slice index out of range.");
+        }
 
-    // constexpr const_iterator begin() const noexcept;
-    // constexpr const_iterator cbegin() const noexcept;
-    // constexpr const_iterator end() const noexcept;
-    // constexpr const_iterator cend() const noexcept;
-    // constexpr const_reverse_iterator rbegin() const noexcept;
-    // constexpr const_reverse_iterator crbegin() const noexcept;
-    // constexpr const_reverse_iterator rend() const noexcept;
-    // constexpr const_reverse_iterator crend() const noexcept;
-    inline auto operator$generator() -> helix::$generator<CharT> {}
+        return m_data[pos];
+    }
 
-    auto iter() -> helix::$generator<CharT> { return operator$generator(); }
+    constexpr reference front() const noexcept { return m_data[0]; }
+    constexpr reference back() const noexcept { return m_data[m_size - 1]; }
+    constexpr pointer   data() const noexcept { return m_data; }
 
-    auto begin() { return $gen_state.begin(); }
-    auto cbegin() { return $gen_state.cbegin(); }
-    auto end() { return $gen_state.end(); }
+    [[nodiscard]] constexpr LIBCXX_NAMESPACE::basic_string_view<CharT> view() const noexcept
+        requires(_string::has_traits<CharT>)
+    {
+        return {m_data, m_size};
+    }
 
-    constexpr slice split(size_type pos, size_type count) const;
-    constexpr int   compare(const slice &other) const noexcept;
+    constexpr operator LIBCXX_NAMESPACE::basic_string_view<CharT>() const noexcept  // NOLINT(google-explicit-constructor)
+        requires(_string::has_traits<CharT>)
+    {
+        return view();
+    }
 
-    constexpr void left_strip(size_type n) noexcept;
-    constexpr void right_strip(size_type n) noexcept;
+    [[nodiscard]] constexpr bool      empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] constexpr size_type size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr size_type length() const noexcept { return m_size; }
 
-    friend constexpr bool operator==(const slice &lhs, const slice &rhs) noexcept {
-        return lhs.size() == rhs.size() && LIBCXX_NAMESPACE::equal(lhs.begin(), lhs.end(), rhs.begin());
+    constexpr const_iterator         begin() const noexcept { return m_data; }
+    constexpr const_iterator         cbegin() const noexcept { return m_data; }
+    constexpr const_iterator         end() const noexcept { return m_data + m_size; }
+    constexpr const_iterator         cend() const noexcept { return m_data + m_size; }
+    constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end()); }
+    constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
+
+    /// lazily yields every character, prefer the iterators in c++ code. the generator holds its
+    /// own copy of the view, so it may outlive this slice (not the characters).
+    auto iter() const -> helix::$generator<CharT> { return generate(*this); }
+
+    /// the `count` characters starting at `pos`, clamped to the end of the slice.
+    constexpr slice split(size_type pos, size_type count = npos) const {
+        if (pos > m_size) {
+            throw H_STD_NAMESPACE::errors::RuntimeError("slice split position out of range.");
+        }
+
+        const size_type left = m_size - pos;
+        return {m_data + pos, count < left ? count : left};
+    }
+
+    constexpr int compare(const slice &other) const noexcept {
+        const size_type common = m_size < other.m_size ? m_size : other.m_size;
+        const int       result = _string::compare(m_data, other.m_data, common);
+
+        if (result != 0) {
+            return result;
+        }
+
+        return m_size == other.m_size ? 0 : (m_size < other.m_size ? -1 : 1);
+    }
+
+    /// position of the first `chr` at or after `from`, `npos` when there is none.
+    constexpr size_type find(CharT chr, size_type from = 0) const noexcept {
+        if (from >= m_size) {
+            return npos;
+        }
+
+        const CharT *found = nullptr;
+
+        if constexpr (_string::is_byte<CharT>) {
+            if (!LIBCXX_NAMESPACE::is_constant_evaluated()) {
+                found = bytes(_search::kernels().find_byte(as_bytes(m_data + from), as_bytes(end()), static_cast<char>(chr)));
+                return found != end() ? static_cast<size_type>(found - m_data) : npos;
+            }
+        }
+
+        found = LIBCXX_NAMESPACE::find(m_data + from, end(), chr);
+        return found != end() ? static_cast<size_type>(found - m_data) : npos;
+    }
+
+    /// position of the first occurrence of `needle` at or after `from`, `npos` when there is none.
+    constexpr size_type find(const slice &needle, size_type from = 0) const noexcept {
+        if (from > m_size) {
+            return npos;
+        }
+
+        const CharT *found = nullptr;
+
+        if constexpr (_string::is_byte<CharT>) {
+            if (!LIBCXX_NAMESPACE::is_constant_evaluated()) {
+                found = bytes(_search::kernels().find(as_bytes(m_data + from), as_bytes(end()), as_bytes(needle.m_data), needle.m_size));
+                return found != end() || needle.empty() ? static_cast<size_type>(found - m_data) : npos;
+            }
+        }
+
+        found = LIBCXX_NAMESPACE::search(m_data + from, end(), needle.begin(), needle.end());
+        return found != end() || needle.empty() ? static_cast<size_type>(found - m_data) : npos;
+    }
+
+    constexpr size_type count(CharT chr) const noexcept {
+        if constexpr (_string::is_byte<CharT>) {
+            if (!LIBCXX_NAMESPACE::is_constant_evaluated()) {
+                return _search::kernels().count_byte(as_bytes(begin()), as_bytes(end()), static_cast<char>(chr));
+            }
+        }
+
+        return static_cast<size_type>(LIBCXX_NAMESPACE::count(begin(), end(), chr));
+    }
+
+    /// number of non-overlapping occurrences of `needle`, an empty needle counts as none.
+    constexpr size_type count(const slice &needle) const noexcept {
+        if constexpr (_string::is_byte<CharT>) {
+            if (!LIBCXX_NAMESPACE::is_constant_evaluated()) {
+                return _search::count(as_bytes(begin()), as_bytes(end()), as_bytes(needle.m_data), needle.m_size);
+            }
+        }
+
+        size_type count = 0;
+
+        for (size_type pos = 0; !needle.empty() && (pos = find(needle, pos)) != npos; pos += needle.m_size) {
+            ++count;
+        }
+
+        return count;
+    }
+
+    constexpr bool contains(CharT chr) const noexcept { return find(chr) != npos; }
+    constexpr bool contains(const slice &needle) const noexcept { return find(needle) != npos; }
+
+    constexpr bool starts_with(const slice &prefix) const noexcept {
+        return prefix.m_size <= m_size && _string::compare(m_data, prefix.m_data, prefix.m_size) == 0;
     }
-    friend constexpr bool operator!=(const slice &lhs, const slice &rhs) noexcept {
-        return !(lhs == rhs);
+
+    constexpr bool ends_with(const slice &suffix) const noexcept {
+        return suffix.m_size <= m_size && _string::compare(end() - suffix.m_size, suffix.m_data, suffix.m_size) == 0;
+    }
+
+    /// drop `n` characters from the front.
+    constexpr void left_strip(size_type n) noexcept {
+        n       = n < m_size ? n : m_size;
+        m_data += n;
+        m_size -= n;
     }
-    friend constexpr bool operator<(const slice &lhs, const slice &rhs) noexcept {
-        return LIBCXX_NAMESPACE::lexicographical_compare(
-            lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+
+    /// drop `n` characters from the back.
+    constexpr void right_strip(size_type n) noexcept { m_size -= n < m_size ? n : m_size; }
+
+    friend constexpr bool operator==(const slice &lhs, const slice &rhs) noexcept {
+        return lhs.m_size == rhs.m_size && _string::compare(lhs.m_data, rhs.m_data, lhs.m_size) == 0;
     }
-    friend constexpr bool operator<=(const slice &lhs, const slice &rhs) noexcept {
-        return !(rhs < lhs);
+    friend constexpr bool operator!=(const slice &lhs, const slice &rhs) noexcept { return !(lhs == rhs); }
+    friend constexpr bool operator<(const slice &lhs, const slice &rhs) noexcept { return lhs.compare(rhs) < 0; }
+    friend constexpr bool operator<=(const slice &lhs, const slice &rhs) noexcept { return lhs.compare(rhs) <= 0; }
+    friend constexpr bool operator>(const slice &lhs, const slice &rhs) noexcept { return lhs.compare(rhs) > 0; }
+    friend constexpr bool operator>=(const slice &lhs, const slice &rhs) noexcept { return lhs.compare(rhs) >= 0; }
+
+    /// exact matches for `string_view` operands, which convert both ways and would otherwise make
+    /// every comparison ambiguous; a template so that nothing converts to `View` to get here.
+    template <typename View>
+        requires(std::Meta::same_as<View, LIBCXX_NAMESPACE::basic_string_view<CharT>>)
+    friend constexpr bool operator==(const slice &lhs, View rhs) noexcept {
+        return lhs == slice(rhs);
     }
-    friend constexpr bool operator>(const slice &lhs, const slice &rhs) noexcept {
-        return rhs < lhs;
+
+    template <typename View>
+        requires(std::Meta::same_as<View, LIBCXX_NAMESPACE::basic_string_view<CharT>>)
+    friend constexpr auto operator<=>(const slice &lhs, View rhs) noexcept {
+        return lhs.compare(slice(rhs)) <=> 0;
     }
-    friend constexpr bool operator>=(const slice &lhs, const slice &rhs) noexcept {
-        return !(lhs < rhs);
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const
+        requires(std::Meta::same_as<CharT, char>)
+    {
+        out.append(m_data, m_size);
     }
 
   private:
-    const_pointer m_data;
-    size_type     m_size;
+    static const char *as_bytes(const CharT *ptr) noexcept { return reinterpret_cast<const char *>(ptr); }
+    static const CharT *bytes(const char *ptr) noexcept { return reinterpret_cast<const CharT *>(ptr); }
+
+    static auto generate(slice self) -> helix::$generator<CharT> {
+        for (const CharT chr : self) {
+            co_yield chr;
+        }
+    }
+
+    const_pointer m_data = nullptr;
+    size_type     m_size = 0;
 };
 
-template <typename CharT, const usize _SlabSize = 16>  // NOLINT
-    requires(std::Interfaces::CharaterCompliance<CharT>)
+/// \class basic
+///
+/// An owning string that keeps its characters in one of three places, chosen per string and only
+/// changed when an operation needs it.
+///
+/// ### Storage
+/// - **Stack**: up to `_SlabSize` characters live inside the object itself, nothing is allocated.
+/// - **ROM**: a string literal (`String::literal`, `"text"_s`) is referenced where the compiler
+///   placed it, nothing is copied until the string is modified (guarantee 1 above).
+/// - **Heap**: longer strings own a buffer that grows geometrically, doubling on each growth.
+/// - **Foreign**: the buffer of a `std::basic_string` (`helix::string`) moved into the string, kept
+///   as it is and read only like a literal until the string is modified.
+///
+/// ### Design Details
+/// - The characters are always followed by a null character, `c_str()` never copies.
+/// - Only a `String::literal` (`"text"_s`) is referenced; character arrays and pointers are
+///   always copied, to the slab when they fit (guarantee 2 above), since an array may be a stack
+///   buffer or one that changes later.
+/// - Copying a ROM string copies the reference, copying a stack string copies the slab, copying a
+///   heap string allocates exactly its size (or moves back to the slab when it fits).
+/// - Any modification of a ROM string, including truncation, first moves it to the stack or heap.
+/// - Heap buffers come from `_Allocator` (any `std::Memory::Allocator`), the global heap by
+///   default. An allocator handle is copied into copies of the string and taken along by moves;
+///   strings made by the string's own operations (`find_replace`) use the same allocator, so a
+///   string in an `std::Memory::Arena` stays in it.
+/// - `view()` and the conversion to `std::basic_string_view` borrow the characters, moving a
+///   standard string in and `into_std()` hand its buffer over both ways, none of them copy.
+template <typename CharT, const usize _SlabSize = 16, typename _Allocator = std::Memory::DefaultAllocator>  // NOLINT
+    requires(std::Interfaces::CharaterCompliance<CharT> && std::Memory::Allocator<_Allocator>)
 class basic {
+    static_assert(LIBCXX_NAMESPACE::is_trivially_copyable_v<CharT>,
+                  "String::basic copies characters with memcpy");
+
+  public:
+    enum StorageLocation : u8 { Stack, ROM, Heap, Foreign };
+
+    using value_type      = CharT;
+    using size_type       = usize;
+    using difference_type = isize;
+    using reference       = CharT &;
+    using const_reference = const CharT &;
+    using pointer         = CharT *;
+    using const_pointer   = const CharT *;
+    using allocator_type  = _Allocator;
+
+    static constexpr size_type slab_size = _SlabSize;
+
+    basic() noexcept = default;
+
+    /// an empty string whose buffers will come from `allocator`.
+    explicit basic(const _Allocator &allocator) noexcept
+        : m_allocator(allocator) {}
+
+    /// references the literal in place, see the class notes.
+    basic(literal<CharT> text) noexcept  // NOLINT(google-explicit-constructor)
+        : m_size(text.size())
+        , m_location(ROM) {
+        m_storage.rom = text.data();
+    }
+
+    /// copies the array up to its first null character (all of it when there is none).
+    template <usize N>
+    basic(const CharT (&array)[N])  // NOLINT(google-explicit-constructor)
+        : basic(array, _string::array_length(array)) {}
+
+    template <usize N>
+    basic(CharT (&buffer)[N])  // NOLINT(google-explicit-constructor)
+        : basic(buffer, _string::array_length(buffer)) {}
+
+    /// a template so that an array prefers the array overloads above.
+    template <typename Ptr>
+        requires(std::Meta::same_as<Ptr, const CharT *> || std::Meta::same_as<Ptr, CharT *>)
+    basic(Ptr str)  // NOLINT(google-explicit-constructor)
+        : basic(str, length_of(str)) {}
+
+    basic(const CharT *str, size_type size) { init(str, size); }
+
+    basic(const CharT *str, size_type size, const _Allocator &allocator)
+        : m_allocator(allocator) {
+        init(str, size);
+    }
+
+    /// copies the viewed characters.
+    template <typename Traits>
+    explicit basic(LIBCXX_NAMESPACE::basic_string_view<CharT, Traits> view) { init(view.data(), view.size()); }
+
+    /// \brief takes over the standard string's buffer, the characters are not copied.
+    ///
+    /// the standard string itself is moved into a small node the string owns (`Foreign`), taken
+    /// from `_Allocator` like any other buffer and freed when the string is destroyed or first
+    /// modified. strings that fit the slab are copied there instead, a short standard string keeps
+    /// its characters inline anyway.
+    basic(LIBCXX_NAMESPACE::basic_string<CharT> &&str)  // NOLINT(google-explicit-constructor)
+        requires(_string::has_traits<CharT>)
+    {
+        take_foreign(LIBCXX_NAMESPACE::move(str));
+    }
+
+    basic(LIBCXX_NAMESPACE::basic_string<CharT> &&str, const _Allocator &allocator)
+        requires(_string::has_traits<CharT>)
+        : m_allocator(allocator) {
+        take_foreign(LIBCXX_NAMESPACE::move(str));
+    }
+
+    basic(size_type count, CharT chr) {
+        init(nullptr, count);
+
+        CharT *dest = mutable_data();
+        for (size_type i = 0; i < count; ++i) {
+            dest[i] = chr;
+        }
+    }
+
+    basic(const basic &other)
+        : m_allocator(other.m_allocator) {
+        if (other.m_location == ROM) {
+            m_storage.rom = other.m_storage.rom;
+            m_size        = other.m_size;
+            m_location    = ROM;
+        } else {
+            init(other.data(), other.m_size);
+        }
+    }
+
+    basic(basic &&other) noexcept
+        : m_storage(other.m_storage)
+        , m_size(other.m_size)
+        , m_location(other.m_location)
+        , m_allocator(other.m_allocator) {
+        other.reset();
+    }
+
+    basic &operator=(const basic &other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if (other.m_location == ROM) {
+            release();
+
+            m_storage.rom = other.m_storage.rom;
+            m_size        = other.m_size;
+            m_location    = ROM;
+
+            return *this;
+        }
+
+        return assign(other.data(), other.m_size);
+    }
+
+    basic &operator=(basic &&other) noexcept {
+        if (this != &other) {
+            release();
+
+            m_storage   = other.m_storage;
+            m_size      = other.m_size;
+            m_location  = other.m_location;
+            m_allocator = other.m_allocator;  // the buffer goes back to the allocator it came from
+
+            other.reset();
+        }
+
+        return *this;
+    }
+
+    ~basic() { release(); }
+
+    /// replace the contents with `size` characters from `str`, reusing the current buffer when it
+    /// is large enough.
+    basic &assign(const CharT *str, size_type size) {
+        if (!read_only() && size <= capacity()) {
+            LIBCXX_NAMESPACE::memmove(mutable_data(), str, size * sizeof(CharT));
+            set_size(size);
+
+            return *this;
+        }
+
+        basic copy(str, size, m_allocator);  // `str` may point into this string
+        return *this = LIBCXX_NAMESPACE::move(copy);
+    }
+
+    /// \brief a string that takes over `buffer`, which holds `size` characters and was allocated
+    /// with `::operator new((capacity + 1) * sizeof(CharT))`, the extra one for the terminator.
+    ///
+    /// nothing is copied unless the characters fit the slab, then the buffer is freed; this is
+    /// how `String::builder` hands over what it built.
+    static basic adopt(CharT *buffer, size_type capacity, size_type size)
+        requires(std::Meta::same_as<_Allocator, std::Memory::DefaultAllocator>)
+    {
+        basic result;
+
+        if (size <= _SlabSize) {
+            LIBCXX_NAMESPACE::memcpy(result.m_storage.stack, buffer, size * sizeof(CharT));
+            result.deallocate(buffer, capacity);
+        } else {
+            result.m_storage.heap = {buffer, capacity};
+            result.m_location     = Heap;
+        }
+
+        result.set_size(size);
+        return result;
+    }
+
+    [[nodiscard]] const_pointer data() const noexcept {
+        switch (m_location) {
+            case Stack:
+                return m_storage.stack;
+            case ROM:
+                return m_storage.rom;
+            case Foreign:
+                return m_storage.foreign.ptr;
+            default:
+                return m_storage.heap.ptr;
+        }
+    }
+
+    [[nodiscard]] const_pointer   c_str() const noexcept { return data(); }
+    [[nodiscard]] size_type       size() const noexcept { return m_size; }
+    [[nodiscard]] size_type       length() const noexcept { return m_size; }
+    [[nodiscard]] bool            empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] StorageLocation location() const noexcept { return m_location; }
+
+    /// characters that fit without allocating; ROM and foreign strings have none to spare.
+    [[nodiscard]] size_type capacity() const noexcept {
+        switch (m_location) {
+            case Stack:
+                return _SlabSize;
+            case ROM:
+            case Foreign:
+                return m_size;
+            default:
+                return m_storage.heap.capacity;
+        }
+    }
+
+    const_reference operator[](size_type pos) const noexcept { return data()[pos]; }
+
+    /// mutable access, moves a ROM string out of read-only memory first.
+    reference operator[](size_type pos) { return mutable_data()[pos]; }
+
+    const_reference front() const noexcept { return data()[0]; }
+    const_reference back() const noexcept { return data()[m_size - 1]; }
+
+    [[nodiscard]] slice<CharT> as_slice() const noexcept { return {data(), m_size}; }
+    operator slice<CharT>() const noexcept { return as_slice(); }  // NOLINT(google-explicit-constructor)
+
+    [[nodiscard]] LIBCXX_NAMESPACE::basic_string_view<CharT> view() const noexcept
+        requires(_string::has_traits<CharT>)
+    {
+        return {data(), m_size};
+    }
+
+    operator LIBCXX_NAMESPACE::basic_string_view<CharT>() const noexcept  // NOLINT(google-explicit-constructor)
+        requires(_string::has_traits<CharT>)
+    {
+        return view();
+    }
+
+    /// \brief the characters as a standard string, leaving this one empty.
+    ///
+    /// a string that was moved in from a standard string gives that buffer back untouched; any
+    /// other storage is copied once, a standard string cannot take over a buffer it did not make.
+    [[nodiscard]] LIBCXX_NAMESPACE::basic_string<CharT> into_std() &&
+        requires(_string::has_traits<CharT>)
+    {
+        LIBCXX_NAMESPACE::basic_string<CharT> result;
+
+        if (m_location == Foreign) {
+            result = LIBCXX_NAMESPACE::move(*m_storage.foreign.owner);
+        } else {
+            result.assign(data(), m_size);
+        }
+
+        release();
+        reset();
+
+        return result;
+    }
+
+    [[nodiscard]] const CharT *begin() const noexcept { return data(); }
+    [[nodiscard]] const CharT *end() const noexcept { return data() + m_size; }
+
+    [[nodiscard]] size_type find(CharT chr, size_type from = 0) const noexcept { return as_slice().find(chr, from); }
+    [[nodiscard]] size_type find(slice<CharT> needle, size_type from = 0) const noexcept {
+        return as_slice().find(needle, from);
+    }
+
+    [[nodiscard]] size_type count(CharT chr) const noexcept { return as_slice().count(chr); }
+    [[nodiscard]] size_type count(slice<CharT> needle) const noexcept { return as_slice().count(needle); }
+
+    [[nodiscard]] bool contains(CharT chr) const noexcept { return as_slice().contains(chr); }
+    [[nodiscard]] bool contains(slice<CharT> needle) const noexcept { return as_slice().contains(needle); }
+    [[nodiscard]] bool starts_with(slice<CharT> prefix) const noexcept { return as_slice().starts_with(prefix); }
+    [[nodiscard]] bool ends_with(slice<CharT> suffix) const noexcept { return as_slice().ends_with(suffix); }
+
+    /// \brief a copy with every non-overlapping `from` replaced by `to`.
+    ///
+    /// matches are counted first, so the result is allocated once at its exact size; with no
+    /// match the copy keeps this string's storage (a literal stays a reference).
+    [[nodiscard]] basic find_replace(slice<CharT> from, slice<CharT> to) const {
+        const slice<CharT> self    = as_slice();
+        const size_type    matches = from.empty() ? 0 : self.count(from);
+
+        if (matches == 0) {
+            return *this;
+        }
+
+        basic result(m_allocator);
+        result.reserve(m_size - matches * from.size() + matches * to.size());
+
+        size_type done = 0;
+        for (size_type pos = self.find(from); pos != slice<CharT>::npos; pos = self.find(from, done)) {
+            result.append(self.data() + done, pos - done);
+            result.append(to.data(), to.size());
+
+            done = pos + from.size();
+        }
+
+        result.append(self.data() + done, m_size - done);
+        return result;
+    }
+
+    /// \brief a copy with every `from` character replaced by `to`.
+    [[nodiscard]] basic find_replace(CharT from, CharT to) const {
+        if (!contains(from)) {
+            return *this;
+        }
+
+        basic  result(data(), m_size, m_allocator);
+        CharT *chars = result.mutable_data();
+
+        for (size_type i = 0; i < m_size; ++i) {  // branchless, vectorized by the compiler
+            chars[i] = chars[i] == from ? to : chars[i];
+        }
+
+        return result;
+    }
+
+    /// make room for `count` characters without further allocation.
+    void reserve(size_type count) {
+        if (count > capacity() || read_only()) {
+            relocate(count > m_size ? count : m_size, nullptr, 0);
+        }
+    }
+
+    /// \brief give back unused capacity: a heap string moves to an exact fit buffer, or to the
+    /// slab when it fits there.
+    void shrink_to_fit() {
+        if (m_location != Heap || m_storage.heap.capacity == m_size) {
+            return;
+        }
+
+        CharT          *old      = m_storage.heap.ptr;
+        const size_type capacity = m_storage.heap.capacity;
+
+        if (m_size <= _SlabSize) {
+            LIBCXX_NAMESPACE::memcpy(m_storage.stack, old, m_size * sizeof(CharT));
+            m_location = Stack;
+        } else {
+            CharT *block = allocate(m_size);
+            LIBCXX_NAMESPACE::memcpy(block, old, m_size * sizeof(CharT));
+
+            m_storage.heap = {block, m_size};
+        }
+
+        deallocate(old, capacity);
+        set_size(m_size);
+    }
+
+    [[nodiscard]] const _Allocator &get_allocator() const noexcept { return m_allocator; }
+
+    void clear() noexcept {
+        if (read_only()) {
+            release();
+            reset();
+        } else {
+            set_size(0);
+        }
+    }
+
+    basic &append(const CharT *str, size_type count) {
+        const size_type size = m_size + count;
+
+        if (!read_only() && size <= capacity()) {
+            LIBCXX_NAMESPACE::memmove(mutable_data() + m_size, str, count * sizeof(CharT));
+            set_size(size);
+        } else {
+            relocate(grown_capacity(size), str, count);
+        }
+
+        return *this;
+    }
+
+    basic &append(const basic &other) { return append(other.data(), other.m_size); }
+    basic &append(const CharT *str) { return append(str, length_of(str)); }
+
+    void push_back(CharT chr) { append(&chr, 1); }
+
+    /// remove the last character.
+    void pop() {
+        if (m_size != 0) {
+            const size_type size = m_size - 1;
+
+            make_mutable(size);
+            set_size(size);
+        }
+    }
+
+    /// change the size to `count`, new characters are `chr`.
+    void resize(size_type count, CharT chr = CharT()) {
+        if (count > m_size) {
+            reserve(count);
+
+            CharT *dest = mutable_data();
+            for (size_type i = m_size; i < count; ++i) {
+                dest[i] = chr;
+            }
+        } else {
+            make_mutable(count);
+        }
+
+        set_size(count);
+    }
+
+    /// \brief change the size to at most `count` without initializing the new characters.
+    ///
+    /// `fill(chars, count)` writes the characters and returns how many it kept, the string is
+    /// truncated to that. meant for producers that know an upper bound of their output (the
+    /// encoders in `string/unicode.hh`), so nothing is written twice.
+    template <typename Fill>
+    void resize_and_overwrite(size_type count, Fill fill) {
+        reserve(count);
+
+        const size_type size = static_cast<size_type>(fill(mutable_data(), count));
+        set_size(size < count ? size : count);
+    }
+
+    basic &operator+=(const basic &other) { return append(other); }
+    basic &operator+=(const CharT *str) { return append(str); }
+    basic &operator+=(CharT chr) {
+        push_back(chr);
+        return *this;
+    }
+
+    friend bool operator==(const basic &lhs, const basic &rhs) noexcept { return lhs.as_slice() == rhs.as_slice(); }
+    friend bool operator!=(const basic &lhs, const basic &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator<(const basic &lhs, const basic &rhs) noexcept { return lhs.as_slice() < rhs.as_slice(); }
+
+    friend bool operator>(const basic &lhs, const basic &rhs) noexcept { return rhs < lhs; }
+    friend bool operator<=(const basic &lhs, const basic &rhs) noexcept { return !(rhs < lhs); }
+    friend bool operator>=(const basic &lhs, const basic &rhs) noexcept { return !(lhs < rhs); }
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const
+        requires(std::Meta::same_as<CharT, char>)
+    {
+        out.append(data(), m_size);
+    }
+
   private:
-    enum StorageLocation { Stack, ROM, Heap };
+    union Storage {
+        CharT stack[_SlabSize + 1];
+
+        struct {
+            CharT    *ptr;
+            size_type capacity;
+        } heap;
+
+        const CharT *rom;
+
+        struct {
+            const CharT                           *ptr;
+            LIBCXX_NAMESPACE::basic_string<CharT> *owner;
+        } foreign;
+    };
+
+    static size_type length_of(const CharT *str) noexcept {
+        size_type size = 0;
+
+        if (str != nullptr) {
+            while (str[size] != CharT()) {
+                ++size;
+            }
+        }
+
+        return size;
+    }
+
+    /// room for `capacity` characters and the terminator.
+    CharT *allocate(size_type capacity) {
+        return static_cast<CharT *>(m_allocator.alloc((capacity + 1) * sizeof(CharT), alignof(CharT)));
+    }
+
+    void deallocate(CharT *block, size_type capacity) noexcept {
+        m_allocator.dealloc(block, (capacity + 1) * sizeof(CharT), alignof(CharT));
+    }
+
+    CharT *mutable_data() {
+        make_mutable();
+        return m_location == Stack ? m_storage.stack : m_storage.heap.ptr;
+    }
+
+    /// ROM and foreign characters are never written in place.
+    [[nodiscard]] bool read_only() const noexcept { return m_location == ROM || m_location == Foreign; }
 
-    basic(const CharT *rom_ptr);
-    basic(CharT *rom_ptr);
-    basic(basic<CharT> rom_ptr);
+    void make_mutable() {
+        if (read_only()) {
+            relocate(m_size, nullptr, 0);
+        }
+    }
+
+    /// the same when the string is about to be cut to `count` characters: only those are moved,
+    /// to the slab when they fit.
+    void make_mutable(size_type count) {
+        if (read_only()) {
+            m_size = count;
+            relocate(count, nullptr, 0);
+        }
+    }
+
+    void set_size(size_type size) noexcept {
+        m_size = size;
+        (m_location == Stack ? m_storage.stack : m_storage.heap.ptr)[size] = CharT();
+    }
+
+    [[nodiscard]] size_type grown_capacity(size_type required) const noexcept {
+        if (required <= _SlabSize) {
+            return _SlabSize;  // only reached from ROM or Foreign, the result fits the slab
+        }
+
+        size_type capacity = this->capacity() * 2;
+
+        if (capacity < _SlabSize * 2) {
+            capacity = _SlabSize * 2;
+        }
+
+        return capacity < required ? required : capacity;
+    }
+
+    /// fill a newly constructed string with `size` characters from `str` (uninitialized when
+    /// null). the destination is kept in a local: `memcpy` may alias `m_location`, and reading it
+    /// back would let the compiler consider a slab write past `_SlabSize`.
+    void init(const CharT *str, size_type size) {
+        CharT *dest = m_storage.stack;
+
+        if (size > _SlabSize) {
+            dest           = allocate(size);
+            m_storage.heap = {dest, size};
+            m_location     = Heap;
+        }
+
+        if (str != nullptr) {
+            LIBCXX_NAMESPACE::memcpy(dest, str, size * sizeof(CharT));
+        }
+
+        dest[size] = CharT();
+        m_size     = size;
+    }
+
+    /// take `str` as the `Foreign` storage of a newly constructed string, or copy it to the slab
+    /// when it fits.
+    void take_foreign(LIBCXX_NAMESPACE::basic_string<CharT> &&str) {
+        using owner_type = LIBCXX_NAMESPACE::basic_string<CharT>;
+
+        if (str.size() <= _SlabSize) {
+            init(str.data(), str.size());
+            return;
+        }
+
+        void *node  = m_allocator.alloc(sizeof(owner_type), alignof(owner_type));
+        auto *owner = ::new (node) owner_type(LIBCXX_NAMESPACE::move(str));
+
+        m_storage.foreign = {owner->data(), owner};
+        m_size            = owner->size();
+        m_location        = Foreign;
+    }
+
+    /// move the contents into storage of at least `capacity` characters, then append `extra`,
+    /// which may point into the current storage.
+    void relocate(size_type capacity, const CharT *extra, size_type count) {
+        const size_type size = m_size + count;
+
+        if (read_only() && capacity <= _SlabSize) {
+            const Storage         old  = m_storage;  // the slab overlaps the references
+            const StorageLocation from = m_location;
+
+            LIBCXX_NAMESPACE::memcpy(m_storage.stack, from == ROM ? old.rom : old.foreign.ptr, m_size * sizeof(CharT));
+            if (count != 0) {
+                LIBCXX_NAMESPACE::memcpy(m_storage.stack + m_size, extra, count * sizeof(CharT));
+            }
+
+            m_location = Stack;
+            set_size(size);
+
+            if (from == Foreign) {
+                drop_owner(old.foreign.owner);  // last, `extra` may point into its buffer
+            }
+
+            return;
+        }
+
+        if (m_location == Heap) {
+            grow_heap(capacity, extra, count);
+            return;
+        }
+
+        CharT *block = allocate(capacity);
+
+        LIBCXX_NAMESPACE::memcpy(block, data(), m_size * sizeof(CharT));
+        if (count != 0) {
+            LIBCXX_NAMESPACE::memcpy(block + m_size, extra, count * sizeof(CharT));
+        }
+
+        release();
+
+        m_storage.heap = {block, capacity};
+        m_location     = Heap;
+        set_size(size);
+    }
+
+    /// heap to heap through `_Allocator::realloc`, which an arena extends in place when the buffer
+    /// is its newest block instead of leaving the old one behind. `extra` may point into the
+    /// buffer, which `realloc` may free, so such a pointer is carried over as an offset.
+    void grow_heap(size_type capacity, const CharT *extra, size_type count) {
+        const CharT *old    = m_storage.heap.ptr;
+        const bool   inside = count != 0 && !LIBCXX_NAMESPACE::less<const CharT *>()(extra, old) &&
+                            LIBCXX_NAMESPACE::less<const CharT *>()(extra, old + m_storage.heap.capacity + 1);
+        const size_type offset = inside ? static_cast<size_type>(extra - old) : 0;
+
+        auto *block = static_cast<CharT *>(m_allocator.realloc(m_storage.heap.ptr, (m_storage.heap.capacity + 1) * sizeof(CharT),
+                                                                (capacity + 1) * sizeof(CharT), alignof(CharT)));
+
+        if (count != 0) {
+            LIBCXX_NAMESPACE::memmove(block + m_size, inside ? block + offset : extra, count * sizeof(CharT));
+        }
+
+        m_storage.heap = {block, capacity};
+        set_size(m_size + count);
+    }
+
+    void release() noexcept {
+        if (m_location == Heap) {
+            deallocate(m_storage.heap.ptr, m_storage.heap.capacity);
+        } else if constexpr (_string::has_traits<CharT>) {
+            if (m_location == Foreign) {
+                drop_owner(m_storage.foreign.owner);
+            }
+        }
+    }
+
+    /// destroy the node holding a moved-in standard string and give it back to `_Allocator`.
+    void drop_owner(LIBCXX_NAMESPACE::basic_string<CharT> *owner) noexcept {
+        if constexpr (_string::has_traits<CharT>) {
+            using owner_type = LIBCXX_NAMESPACE::basic_string<CharT>;
+
+            owner->~owner_type();
+            m_allocator.dealloc(owner, sizeof(owner_type), alignof(owner_type));
+        }
+    }
+
+    void reset() noexcept {
+        m_storage.stack[0] = CharT();
+        m_size             = 0;
+        m_location         = Stack;
+    }
+
+    Storage         m_storage{};
+    size_type       m_size     = 0;
+    StorageLocation m_location = Stack;
+
+    [[no_unique_address]] _Allocator m_allocator{};
 };
 
-}  // namespace String
+template <typename CharT, typename Lhs, typename Rhs>
+class concat;
+
+namespace _concat {
+    /// the character type of the string types `+` is defined for, void for anything else.
+    template <typename T>
+    struct char_of {
+        using type = void;
+    };
+
+    template <typename CharT>
+    struct char_of<slice<CharT>> {
+        using type = CharT;
+    };
+
+    template <typename CharT, usize S, typename A>
+    struct char_of<basic<CharT, S, A>> {
+        using type = CharT;
+    };
 
-using string = String::basic<wchar_t>;
+    template <typename CharT, typename Lhs, typename Rhs>
+    struct char_of<concat<CharT, Lhs, Rhs>> {
+        using type = CharT;
+    };
+
+    template <typename T>
+    using char_t = typename char_of<LIBCXX_NAMESPACE::remove_cvref_t<T>>::type;
+
+    /// what a node keeps of an operand: strings as a `slice`, a character as itself, a nested
+    /// node by value (two slices at the leaves, cheap to copy).
+    template <typename CharT>
+    constexpr slice<CharT> leaf(const slice<CharT> &text) noexcept {
+        return text;
+    }
+
+    template <typename CharT, usize S, typename A>
+    constexpr slice<CharT> leaf(const basic<CharT, S, A> &text) noexcept {
+        return text.as_slice();
+    }
+
+    template <typename CharT, usize N>
+    constexpr slice<CharT> leaf(const CharT (&array)[N]) noexcept {
+        return {array, _string::array_length(array)};
+    }
+
+    template <typename CharT, typename Ptr>
+        requires(LIBCXX_NAMESPACE::is_same_v<Ptr, const CharT *> || LIBCXX_NAMESPACE::is_same_v<Ptr, CharT *>)
+    constexpr slice<CharT> leaf(Ptr str) noexcept {
+        usize size = 0;
+        while (str[size] != CharT()) {
+            ++size;
+        }
+
+        return {str, size};
+    }
+
+    template <typename CharT, typename Chr>
+        requires(LIBCXX_NAMESPACE::is_same_v<Chr, CharT>)
+    constexpr CharT leaf(Chr chr) noexcept {
+        return chr;
+    }
+
+    template <typename CharT, typename Lhs, typename Rhs>
+    constexpr const concat<CharT, Lhs, Rhs> &leaf(const concat<CharT, Lhs, Rhs> &node) noexcept {
+        return node;
+    }
+
+    template <typename CharT, typename T>
+    using leaf_t = LIBCXX_NAMESPACE::remove_cvref_t<decltype(leaf<CharT>(LIBCXX_NAMESPACE::declval<const T &>()))>;
+
+    template <typename CharT, typename Piece>
+    constexpr usize size(const Piece &piece) noexcept {
+        if constexpr (LIBCXX_NAMESPACE::is_same_v<Piece, CharT>) {
+            return 1;
+        } else {
+            return piece.size();
+        }
+    }
+
+    template <typename CharT, typename Piece>
+    CharT *write(CharT *dest, const Piece &piece) noexcept {
+        if constexpr (LIBCXX_NAMESPACE::is_same_v<Piece, CharT>) {
+            *dest = piece;
+            return dest + 1;
+        } else if constexpr (LIBCXX_NAMESPACE::is_same_v<Piece, slice<CharT>>) {
+            LIBCXX_NAMESPACE::memcpy(dest, piece.data(), piece.size() * sizeof(CharT));
+            return dest + piece.size();
+        } else {
+            return piece.write(dest);
+        }
+    }
+
+    /// `+` applies when one side is a helix string and the other a string, literal, pointer or
+    /// character of the same type.
+    template <typename Lhs, typename Rhs>
+    using pair_char_t = LIBCXX_NAMESPACE::conditional_t<LIBCXX_NAMESPACE::is_void_v<char_t<Lhs>>, char_t<Rhs>, char_t<Lhs>>;
+
+    template <typename Lhs, typename Rhs>
+    concept Joinable = !LIBCXX_NAMESPACE::is_void_v<pair_char_t<Lhs, Rhs>> && requires(const Lhs &lhs, const Rhs &rhs) {
+        leaf<pair_char_t<Lhs, Rhs>>(lhs);
+        leaf<pair_char_t<Lhs, Rhs>>(rhs);
+    };
+}  // namespace _concat
+
+/// \class concat
+///
+/// The result of `+` on strings: a node that remembers its two operands instead of joining them.
+/// A chain `a + b + c + d` is a small tree of nodes; turning it into a `basic` adds up the sizes,
+/// allocates once and copies every piece once.
+///
+/// ### Design Details
+/// - **Operands**: strings are kept as slices, characters by value and nested nodes by value, so
+///   nothing is copied or allocated until the result is used.
+/// - **Materializing**: converting to a `basic<CharT, S>` (assigning, passing, `str()`) writes
+///   the pieces straight into the new string, into its slab when the total fits. Formatting a
+///   node writes the pieces to the output without building the string at all.
+///
+/// ### Notes
+/// - The operands are referenced, not copied: a node must be used within the statement that made
+///   it. `basic key = prefix + id + ":" + suffix;` is fine, `auto key = ...` keeps a node that
+///   dangles once temporaries among the operands are gone.
+///
+/// \tparam CharT The element type of the string
+/// \tparam Lhs The left operand as kept by the node
+/// \tparam Rhs The right operand as kept by the node
+template <typename CharT, typename Lhs, typename Rhs>
+class concat {
+  public:
+    using value_type = CharT;
+    using size_type  = usize;
+
+    constexpr concat(const Lhs &lhs, const Rhs &rhs) noexcept
+        : m_lhs(lhs)
+        , m_rhs(rhs) {}
+
+    [[nodiscard]] constexpr size_type size() const noexcept {
+        return _concat::size<CharT>(m_lhs) + _concat::size<CharT>(m_rhs);
+    }
+
+    /// write every piece from `dest` on, returns the end of what was written.
+    CharT *write(CharT *dest) const noexcept { return _concat::write(_concat::write(dest, m_lhs), m_rhs); }
+
+    template <usize _SlabSize = 16, typename _Allocator = std::Memory::DefaultAllocator>
+    basic<CharT, _SlabSize, _Allocator> str(const _Allocator &allocator = {}) const {
+        basic<CharT, _SlabSize, _Allocator> result(allocator);
+        const size_type                     total = size();
+
+        result.resize_and_overwrite(total, [&](CharT *dest, usize) {
+            write(dest);
+            return total;
+        });
+
+        return result;
+    }
+
+    template <usize _SlabSize, typename _Allocator>
+    operator basic<CharT, _SlabSize, _Allocator>() const {  // NOLINT(google-explicit-constructor)
+        return str<_SlabSize, _Allocator>();
+    }
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const
+        requires(std::Meta::same_as<CharT, char>)
+    {
+        format(out, m_lhs);
+        format(out, m_rhs);
+    }
+
+  private:
+    static void format(H_STD_NAMESPACE::Format::Buffer &out, const slice<CharT> &text) { out.append(text.data(), text.size()); }
+    static void format(H_STD_NAMESPACE::Format::Buffer &out, CharT chr) { out.append(&chr, 1); }
+
+    template <typename Node>
+    static void format(H_STD_NAMESPACE::Format::Buffer &out, const Node &node) {
+        node.operator$format(out);
+    }
+
+    Lhs m_lhs;
+    Rhs m_rhs;
+};
+
+/// \include belongs to the helix standard library.
+/// \brief a lazy concatenation, see `concat`; materialized into a `basic` once, at its full size.
+template <typename Lhs, typename Rhs>
+    requires _concat::Joinable<Lhs, Rhs>
+constexpr auto operator+(const Lhs &lhs, const Rhs &rhs) noexcept {
+    using CharT = _concat::pair_char_t<Lhs, Rhs>;
+    using Node  = concat<CharT, _concat::leaf_t<CharT, Lhs>, _concat::leaf_t<CharT, Rhs>>;
+
+    return Node(_concat::leaf<CharT>(lhs), _concat::leaf<CharT>(rhs));
+}
+
+}  // namespace String
 
 H_NAMESPACE_END
 #endif
\ No newline at end of file
@@ -0,0 +1,296 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_ATOM__
+#define __$LIBHELIX_STRING_ATOM__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../../print/buffer.h"
+#include "../string.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+namespace _atom {
+/// An interned string: its text, length and hash, written once and never freed.
+struct Entry {
+    const char *text;
+    usize       size;
+    u64         hash;
+};
+
+/// 64 bit hash of `size` bytes, read 8 at a time. Only computed when a string is interned, an
+/// atom carries the result around afterwards.
+constexpr u64 hash(const char *data, usize size) noexcept {
+    constexpr u64 mul = 0x9E3779B97F4A7C15ULL;
+
+    u64   hash = 0xCBF29CE484222325ULL ^ (size * mul);
+    usize pos  = 0;
+
+    for (; pos + 8 <= size; pos += 8) {
+        u64 word = 0;
+        for (usize i = 0; i < 8; ++i) {  // folded into a single load by the optimizer
+            word |= static_cast<u64>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+        }
+
+        hash = (hash ^ word) * mul;
+        hash ^= hash >> 29;
+    }
+
+    u64 tail = 0;
+    for (usize i = 0; pos + i < size; ++i) {
+        tail |= static_cast<u64>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+    }
+
+    hash = (hash ^ tail) * mul;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+inline constexpr Entry empty_entry = {"", 0, hash("", 0)};
+
+/// \class Table
+///
+/// The process wide intern table, one `Entry` per distinct string.
+///
+/// ### Design Details
+/// - **Shards**: the table is split into `shard_count` independent open-addressed tables chosen
+///   by the high bits of the hash, so threads interning different strings rarely meet.
+/// - **Lock-free hits**: a shard's slot array is published through an atomic pointer and every
+///   slot is an atomic `Entry *` stored with release ordering after the entry is written, so
+///   interning a string that is already present never locks.
+/// - **Locked inserts**: a miss takes the shard's mutex, re-probes and inserts. A shard more than
+///   half full is copied into an array twice the size; the old array is kept (not freed) since
+///   readers may still be probing it, which at most doubles the memory spent on slots.
+/// - **Lifetime**: entries live in append-only blocks and the table is intentionally leaked, an
+///   atom stays valid for the rest of the process, including static destruction.
+class Table {
+  public:
+    static constexpr usize shard_count = 64;
+    static constexpr usize block_size  = 4096;
+
+    static Table &instance() {
+        static Table *table = new Table();  // NOLINT: leaked on purpose, see above
+        return *table;
+    }
+
+    const Entry *intern(const char *data, usize size) {
+        if (size == 0) {
+            return &empty_entry;
+        }
+
+        const u64    hash  = _atom::hash(data, size);
+        Shard       &shard = m_shards[hash >> 58];
+        const Entry *found = probe(shard.slots.load(LIBCXX_NAMESPACE::memory_order_acquire), data, size, hash);
+
+        return found != nullptr ? found : insert(shard, data, size, hash);
+    }
+
+  private:
+    static_assert((u64(1) << (64 - 58)) == shard_count);
+
+    struct Slots {
+        usize                                        mask;
+        LIBCXX_NAMESPACE::atomic<const Entry *>     *items;
+        Slots                                       *retired;
+    };
+
+    struct Shard {
+        LIBCXX_NAMESPACE::atomic<Slots *> slots{nullptr};
+        LIBCXX_NAMESPACE::mutex           lock;
+        usize                             count = 0;
+        char                             *next  = nullptr;
+        usize                             left  = 0;
+    };
+
+    Table() = default;
+
+    static bool matches(const Entry *entry, const char *data, usize size, u64 hash) noexcept {
+        return entry->hash == hash && entry->size == size &&
+               LIBCXX_NAMESPACE::memcmp(entry->text, data, size) == 0;
+    }
+
+    static const Entry *probe(const Slots *slots, const char *data, usize size, u64 hash) noexcept {
+        if (slots == nullptr) {
+            return nullptr;
+        }
+
+        for (usize i = static_cast<usize>(hash);; ++i) {
+            const Entry *entry = slots->items[i & slots->mask].load(LIBCXX_NAMESPACE::memory_order_acquire);
+
+            if (entry == nullptr) {
+                return nullptr;
+            }
+
+            if (matches(entry, data, size, hash)) {
+                return entry;
+            }
+        }
+    }
+
+    static Slots *allocate(usize capacity, Slots *retired) {
+        auto *items = new LIBCXX_NAMESPACE::atomic<const Entry *>[capacity]();
+        return new Slots{capacity - 1, items, retired};
+    }
+
+    static void place(Slots *slots, const Entry *entry) noexcept {
+        for (usize i = static_cast<usize>(entry->hash);; ++i) {
+            auto &item = slots->items[i & slots->mask];
+
+            if (item.load(LIBCXX_NAMESPACE::memory_order_relaxed) == nullptr) {
+                item.store(entry, LIBCXX_NAMESPACE::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    /// copy the text and its entry into the shard's current block, `Entry` first so it is
+    /// aligned, the text right after it.
+    static const Entry *store(Shard &shard, const char *data, usize size, u64 hash) {
+        const usize bytes = (sizeof(Entry) + size + 1 + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+        char       *dest  = nullptr;
+
+        if (bytes > block_size / 4) {  // long strings get a block of their own
+            dest = static_cast<char *>(::operator new(bytes));
+        } else {
+            if (shard.left < bytes) {
+                shard.next = static_cast<char *>(::operator new(block_size));
+                shard.left = block_size;
+            }
+
+            dest = shard.next;
+            shard.next += bytes;
+            shard.left -= bytes;
+        }
+
+        char *text = dest + sizeof(Entry);
+        LIBCXX_NAMESPACE::memcpy(text, data, size);
+        text[size] = '\0';
+
+        return new (dest) Entry{text, size, hash};
+    }
+
+    const Entry *insert(Shard &shard, const char *data, usize size, u64 hash) {
+        LIBCXX_NAMESPACE::lock_guard<LIBCXX_NAMESPACE::mutex> guard(shard.lock);
+
+        Slots *slots = shard.slots.load(LIBCXX_NAMESPACE::memory_order_relaxed);
+
+        if (const Entry *found = probe(slots, data, size, hash); found != nullptr) {
+            return found;  // another thread interned it first
+        }
+
+        if (slots == nullptr || (shard.count + 1) * 2 > slots->mask + 1) {
+            Slots *grown = allocate(slots == nullptr ? 16 : (slots->mask + 1) * 2, slots);
+
+            for (usize i = 0; slots != nullptr && i <= slots->mask; ++i) {
+                if (const Entry *entry = slots->items[i].load(LIBCXX_NAMESPACE::memory_order_relaxed)) {
+                    place(grown, entry);
+                }
+            }
+
+            shard.slots.store(grown, LIBCXX_NAMESPACE::memory_order_release);
+            slots = grown;
+        }
+
+        const Entry *entry = store(shard, data, size, hash);
+        place(slots, entry);
+        ++shard.count;
+
+        return entry;
+    }
+
+    Shard m_shards[shard_count];
+};
+}  // namespace _atom
+
+/// \class atom
+///
+/// An interned string. Every atom with the same text points at the same table entry, so an atom
+/// is one pointer wide, compares by address and carries a hash computed once when the text was
+/// first interned. Meant for keys drawn from a small vocabulary that is used over and over:
+/// field names, metric names, tags.
+///
+/// ### Design Details
+/// - **Interning**: constructing an atom hashes the text and looks it up in a sharded table
+///   (see `_atom::Table`); when the text is already present no lock is taken. Keep atoms around
+///   instead of re-interning on hot paths.
+/// - **Equality and hashing**: `==` compares addresses and `hash()` returns the stored value,
+///   neither looks at the characters.
+/// - **Ordering**: `<` and friends compare entry addresses. That is a strict total order, all
+///   `map<atom, V>` needs, but an arbitrary one: it is neither alphabetical nor interning order
+///   and may differ between runs. Use `compare()` when the text order matters.
+/// - **Lifetime**: interned text is never freed, `data()` and `c_str()` stay valid for the
+///   rest of the process.
+class atom {
+  public:
+    using value_type = char;
+    using size_type  = usize;
+
+    atom() noexcept = default;
+    explicit atom(slice<char> text)
+        : m_entry(_atom::Table::instance().intern(text.data(), text.size())) {}
+
+    template <usize N>
+    explicit atom(const char (&text)[N])
+        : atom(slice<char>(text, _string::array_length(text))) {}
+
+    atom(const atom &) noexcept            = default;
+    atom &operator=(const atom &) noexcept = default;
+
+    [[nodiscard]] const char *data() const noexcept { return m_entry->text; }
+    [[nodiscard]] const char *c_str() const noexcept { return m_entry->text; }
+    [[nodiscard]] size_type   size() const noexcept { return m_entry->size; }
+    [[nodiscard]] size_type   length() const noexcept { return m_entry->size; }
+    [[nodiscard]] bool        empty() const noexcept { return m_entry->size == 0; }
+
+    /// the hash of the text, computed once when it was interned.
+    [[nodiscard]] u64 hash() const noexcept { return m_entry->hash; }
+
+    [[nodiscard]] slice<char> as_slice() const noexcept { return {m_entry->text, m_entry->size}; }
+    operator slice<char>() const noexcept { return as_slice(); }  // NOLINT(google-explicit-constructor)
+
+    /// three way compare of the text itself, for when alphabetical order is wanted.
+    [[nodiscard]] int compare(const atom &other) const noexcept {
+        return m_entry == other.m_entry ? 0 : as_slice().compare(other.as_slice());
+    }
+
+    friend bool operator==(const atom &lhs, const atom &rhs) noexcept { return lhs.m_entry == rhs.m_entry; }
+    friend bool operator!=(const atom &lhs, const atom &rhs) noexcept { return lhs.m_entry != rhs.m_entry; }
+    friend bool operator<(const atom &lhs, const atom &rhs) noexcept {
+        return LIBCXX_NAMESPACE::less<const _atom::Entry *>()(lhs.m_entry, rhs.m_entry);
+    }
+    friend bool operator<=(const atom &lhs, const atom &rhs) noexcept { return !(rhs < lhs); }
+    friend bool operator>(const atom &lhs, const atom &rhs) noexcept { return rhs < lhs; }
+    friend bool operator>=(const atom &lhs, const atom &rhs) noexcept { return !(lhs < rhs); }
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const { out.append(m_entry->text, m_entry->size); }
+
+  private:
+    const _atom::Entry *m_entry = &_atom::empty_entry;
+};
+}  // namespace String
+
+H_NAMESPACE_END
+
+/// hashed containers use the hash stored in the atom, the text is never read.
+template <>
+struct std::hash<helix::String::atom> {
+    size_t operator()(const helix::String::atom &value) const noexcept { return static_cast<size_t>(value.hash()); }
+};
+
+#endif
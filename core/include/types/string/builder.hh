@@ -0,0 +1,299 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_BUILDER__
+#define __$LIBHELIX_STRING_BUILDER__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../string.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+/// \class builder
+///
+/// Assembles a string in one buffer that is handed to a `basic` when done, for code that knows
+/// (or can work out) how long the result will be. `repeat`, `join`, the `*_align` functions and
+/// `basic * n` below are all written with it.
+///
+/// ### Design Details
+/// - **Planning**: the constructor and `reserve` take the final length, so a planned build
+///   allocates exactly once. Without a plan the buffer grows geometrically, doubling.
+/// - **Repeats**: `repeat(pattern, count)` writes the pattern once and then copies what is
+///   already written onto its end, doubling each time, so `n` copies take O(log n) `memcpy`
+///   calls instead of `n`.
+/// - **Handover**: `build()` gives the buffer to the `basic` it returns (see `basic::adopt`), the
+///   characters are not copied again. The builder is empty afterwards and can be reused.
+///
+/// \tparam CharT The element type of the string
+template <typename CharT>
+class builder {
+    static_assert(LIBCXX_NAMESPACE::is_trivially_copyable_v<CharT>, "String::builder copies characters with memcpy");
+
+  public:
+    using value_type = CharT;
+    using size_type  = usize;
+
+    builder() noexcept = default;
+
+    /// plan for `capacity` characters.
+    explicit builder(size_type capacity) { reserve(capacity); }
+
+    builder(const builder &)            = delete;
+    builder &operator=(const builder &) = delete;
+
+    builder(builder &&other) noexcept
+        : m_data(other.m_data)
+        , m_size(other.m_size)
+        , m_capacity(other.m_capacity) {
+        other.reset();
+    }
+
+    builder &operator=(builder &&other) noexcept {
+        if (this != &other) {
+            ::operator delete(m_data);
+
+            m_data     = other.m_data;
+            m_size     = other.m_size;
+            m_capacity = other.m_capacity;
+
+            other.reset();
+        }
+
+        return *this;
+    }
+
+    ~builder() { ::operator delete(m_data); }
+
+    [[nodiscard]] const CharT *data() const noexcept { return m_data; }
+    [[nodiscard]] size_type    size() const noexcept { return m_size; }
+    [[nodiscard]] size_type    capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] bool         empty() const noexcept { return m_size == 0; }
+
+    slice<CharT> as_slice() const noexcept { return {m_data, m_size}; }
+
+    /// make room for `capacity` characters in total, exactly; never shrinks.
+    void reserve(size_type capacity) {
+        if (capacity > m_capacity) {
+            relocate(capacity);
+        }
+    }
+
+    void clear() noexcept { m_size = 0; }
+
+    builder &append(slice<CharT> text) {
+        LIBCXX_NAMESPACE::memcpy(extend(text.size()), text.data(), text.size() * sizeof(CharT));
+        return *this;
+    }
+
+    builder &push_back(CharT chr) {
+        *extend(1) = chr;
+        return *this;
+    }
+
+    /// \brief append `count` characters repeating `pattern` (the last copy may be cut short).
+    builder &repeat(slice<CharT> pattern, size_type count) {
+        if (count == 0 || pattern.empty()) {
+            return *this;
+        }
+
+        CharT          *dest  = extend(count);
+        const size_type first = count < pattern.size() ? count : pattern.size();
+
+        LIBCXX_NAMESPACE::memcpy(dest, pattern.data(), first * sizeof(CharT));
+
+        for (size_type done = first; done < count;) {
+            const size_type chunk = done < count - done ? done : count - done;
+
+            LIBCXX_NAMESPACE::memcpy(dest + done, dest, chunk * sizeof(CharT));
+            done += chunk;
+        }
+
+        return *this;
+    }
+
+    builder &repeat(CharT chr, size_type count) { return repeat(slice<CharT>(&chr, 1), count); }
+
+    /// \brief `count` more characters at the end, uninitialized, for producers that write
+    /// directly; the pointer is valid until the next call that grows the builder.
+    CharT *extend(size_type count) {
+        if (count > m_capacity - m_size) {
+            relocate(grown(m_size + count));
+        }
+
+        CharT *dest = m_data + m_size;
+        m_size += count;
+
+        return dest;
+    }
+
+    /// \brief hand the characters to a string without copying them, the builder is left empty.
+    template <usize _SlabSize = 16>
+    basic<CharT, _SlabSize> build() {
+        if (m_data == nullptr) {
+            return {};
+        }
+
+        CharT          *data     = m_data;
+        const size_type size     = m_size;
+        const size_type capacity = m_capacity;
+
+        reset();
+        return basic<CharT, _SlabSize>::adopt(data, capacity, size);
+    }
+
+  private:
+    [[nodiscard]] size_type grown(size_type required) const noexcept {
+        const size_type doubled = m_capacity * 2;
+        return doubled < required ? required : doubled;
+    }
+
+    /// the buffer always has one character past the capacity, for the terminator `basic` wants.
+    void relocate(size_type capacity) {
+        auto *block = static_cast<CharT *>(::operator new((capacity + 1) * sizeof(CharT)));
+
+        if (m_size != 0) {
+            LIBCXX_NAMESPACE::memcpy(block, m_data, m_size * sizeof(CharT));
+        }
+
+        ::operator delete(m_data);
+
+        m_data     = block;
+        m_capacity = capacity;
+    }
+
+    void reset() noexcept {
+        m_data     = nullptr;
+        m_size     = 0;
+        m_capacity = 0;
+    }
+
+    CharT    *m_data     = nullptr;
+    size_type m_size     = 0;
+    size_type m_capacity = 0;
+};
+
+/// \include belongs to the helix standard library.
+/// \brief `text` repeated `count` times, allocated once. throws `RuntimeError` when the result
+/// would not fit in a `usize`.
+template <usize _SlabSize = 16, typename CharT>
+basic<CharT, _SlabSize> repeat(slice<CharT> text, usize count) {
+    if (!text.empty() && count > LIBCXX_NAMESPACE::numeric_limits<usize>::max() / text.size()) {
+        throw H_STD_NAMESPACE::errors::RuntimeError("repeated string length overflows.");
+    }
+
+    builder<CharT> out(text.size() * count);
+    out.repeat(text, text.size() * count);
+
+    return out.template build<_SlabSize>();
+}
+
+template <typename CharT, usize _SlabSize>
+basic<CharT, _SlabSize> operator*(const basic<CharT, _SlabSize> &text, usize count) {
+    return repeat<_SlabSize>(text.as_slice(), count);
+}
+
+namespace _builder {
+    /// a piece of `join`: a slice, or any string with contiguous `data()`/`size()`.
+    template <typename CharT, typename Piece>
+    slice<CharT> view(const Piece &piece) noexcept {
+        if constexpr (LIBCXX_NAMESPACE::is_convertible_v<const Piece &, slice<CharT>>) {
+            return piece;
+        } else {
+            return {piece.data(), static_cast<usize>(piece.size())};
+        }
+    }
+}  // namespace _builder
+
+/// \include belongs to the helix standard library.
+/// \brief the `pieces` with `separator` between each two.
+///
+/// a range that can be walked twice is measured first and the result allocated once; a single
+/// pass range (a `splitter`, say) grows the builder as it goes.
+template <usize _SlabSize = 16, typename CharT, typename Range>
+basic<CharT, _SlabSize> join(slice<CharT> separator, Range &&pieces) {
+    builder<CharT> out;
+
+    if constexpr (LIBCXX_NAMESPACE::ranges::forward_range<Range>) {
+        usize total = 0;
+        usize count = 0;
+
+        for (const auto &piece : pieces) {
+            total += _builder::view<CharT>(piece).size();
+            ++count;
+        }
+
+        out.reserve(total + (count != 0 ? (count - 1) * separator.size() : 0));
+    }
+
+    bool first = true;
+
+    for (const auto &piece : pieces) {
+        if (!first) {
+            out.append(separator);
+        }
+
+        out.append(_builder::view<CharT>(piece));
+        first = false;
+    }
+
+    return out.template build<_SlabSize>();
+}
+
+namespace _builder {
+    template <usize _SlabSize, typename CharT>
+    basic<CharT, _SlabSize> align(slice<CharT> text, usize width, slice<CharT> fill, usize left_share) {
+        if (text.size() >= width || fill.empty()) {
+            return {text.data(), text.size()};
+        }
+
+        const usize padding = width - text.size();
+        const usize left    = padding * left_share / 2;
+
+        builder<CharT> out(width);
+        out.repeat(fill, left).append(text).repeat(fill, padding - left);
+
+        return out.template build<_SlabSize>();
+    }
+
+    template <typename CharT>
+    inline constexpr CharT space[2] = {CharT(' '), CharT()};
+}  // namespace _builder
+
+/// \include belongs to the helix standard library.
+/// \brief `text` padded to `width` characters with `fill` (repeated, the last copy cut short);
+/// text that is already as wide is returned unchanged.
+template <usize _SlabSize = 16, typename CharT>
+basic<CharT, _SlabSize> left_align(slice<CharT> text, usize width, slice<CharT> fill = {_builder::space<CharT>, 1}) {
+    return _builder::align<_SlabSize>(text, width, fill, 0);
+}
+
+template <usize _SlabSize = 16, typename CharT>
+basic<CharT, _SlabSize> right_align(slice<CharT> text, usize width, slice<CharT> fill = {_builder::space<CharT>, 1}) {
+    return _builder::align<_SlabSize>(text, width, fill, 2);
+}
+
+/// the odd character of padding goes to the right.
+template <usize _SlabSize = 16, typename CharT>
+basic<CharT, _SlabSize> center_align(slice<CharT> text, usize width, slice<CharT> fill = {_builder::space<CharT>, 1}) {
+    return _builder::align<_SlabSize>(text, width, fill, 1);
+}
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
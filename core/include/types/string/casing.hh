@@ -0,0 +1,596 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_CASING__
+#define __$LIBHELIX_STRING_CASING__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../string.hh"
+#include "unicode.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+namespace _casing {
+    struct Record {
+        i32 lower;
+        i32 upper;
+        i32 title;
+        i32 fold;
+        u8  flags;
+    };
+
+    struct Run {
+        u32 first;
+        u16 count;
+        u8  stride;
+        u8  record;
+    };
+
+    struct Special {
+        char32_t point;
+        char32_t lower[3];
+        char32_t upper[3];
+        char32_t title[3];
+        char32_t fold[3];
+    };
+
+    inline constexpr u8 cased   = 1 << 0;
+    inline constexpr u8 special = 1 << 1;
+
+#include "casing_data.inc"
+
+    /// \struct Table
+    ///
+    /// Code point to `records` index, in two stages: `stage1` picks one of the distinct blocks of
+    /// 128 code points, `stage2` holds the index for each code point of that block. Identical
+    /// blocks (almost all of them are empty) are stored once, so the whole table is about 8 KiB.
+    template <usize Blocks>
+    struct Table {
+        static constexpr usize block_bits = 7;
+        static constexpr usize block_size = usize(1) << block_bits;
+
+        u8 stage1[limit >> block_bits];
+        u8 stage2[Blocks][block_size];
+    };
+
+    inline constexpr usize block_bits = Table<1>::block_bits;
+    inline constexpr usize block_size = Table<1>::block_size;
+
+    inline constexpr usize max_blocks = 64;  // distinct blocks, 57 for Unicode 14.0
+    inline constexpr usize max_active = 128;  // runs overlapping one block, 76 for Unicode 14.0
+
+    constexpr bool same_block(const u8 *lhs, const u8 *rhs) {
+        for (usize i = 0; i < block_size; ++i) {
+            if (lhs[i] != rhs[i]) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// \brief walks the blocks in order, filling each from the runs that overlap it, and hands
+    /// `sink` every block with the index of its first identical one.
+    ///
+    /// run once to count the distinct blocks and once to fill the table, since its size has to be
+    /// known first. only the runs overlapping the current block are looked at, which keeps this
+    /// cheap enough to evaluate in every translation unit.
+    template <typename Sink>
+    constexpr usize build_blocks(Sink &&sink) {
+        constexpr usize run_count = sizeof(runs) / sizeof(Run);
+
+        u8    unique[max_blocks][block_size] = {};
+        usize active[max_active]             = {};
+        usize live                           = 0;
+        usize next                           = 0;
+        usize count                          = 0;
+        usize empty                          = max_blocks;
+
+        for (usize block = 0; block < (limit >> block_bits); ++block) {
+            const u32 begin = static_cast<u32>(block << block_bits);
+            const u32 end   = begin + static_cast<u32>(block_size);
+
+            while (next < run_count && runs[next].first < end) {
+                active[live++] = next++;  // sorted by first code point
+            }
+
+            const bool mapped = live != 0;
+
+            if (!mapped && empty < count) {
+                sink(block, empty, nullptr);  // most blocks have no mappings at all
+                continue;
+            }
+
+            u8 entries[block_size] = {};
+
+            for (usize i = 0; i < live;) {
+                const Run &run  = runs[active[i]];
+                const u32  last = run.first + (static_cast<u32>(run.count) - 1) * run.stride;
+                u32        point = run.first;
+
+                if (point < begin) {
+                    point += (begin - point + run.stride - 1) / run.stride * run.stride;
+                }
+
+                for (; point <= last && point < end; point += run.stride) {
+                    entries[point - begin] = run.record;
+                }
+
+                if (last < end) {
+                    active[i] = active[--live];
+                } else {
+                    ++i;
+                }
+            }
+
+            usize found = 0;
+            while (found < count && !same_block(unique[found], entries)) {
+                ++found;
+            }
+
+            if (found == count) {
+                for (usize i = 0; i < block_size; ++i) {
+                    unique[count][i] = entries[i];
+                }
+
+                ++count;
+                sink(block, found, entries);
+
+                if (!mapped) {
+                    empty = found;
+                }
+            } else {
+                sink(block, found, nullptr);
+            }
+        }
+
+        return count;
+    }
+
+    inline constexpr usize block_count = build_blocks([](usize, usize, const u8 *) {});
+
+    consteval Table<block_count> build_table() {
+        Table<block_count> table{};
+
+        build_blocks([&](usize block, usize index, const u8 *entries) {
+            table.stage1[block] = static_cast<u8>(index);
+
+            for (usize i = 0; entries != nullptr && i < block_size; ++i) {
+                table.stage2[index][i] = entries[i];
+            }
+        });
+
+        return table;
+    }
+
+    inline constexpr Table<block_count> table = build_table();
+
+    static_assert(sizeof(records) / sizeof(Record) <= 256, "stage2 holds record indices in a byte");
+
+    constexpr const Record &lookup(char32_t point) noexcept {
+        if (point >= limit) {
+            return records[0];
+        }
+
+        return records[table.stage2[table.stage1[point >> block_bits]][point & (block_size - 1)]];
+    }
+
+    /// the full mappings of a `special` code point, binary search over the ~100 of them.
+    constexpr const Special &special_of(char32_t point) noexcept {
+        usize low  = 0;
+        usize high = sizeof(specials) / sizeof(Special) - 1;
+
+        while (low < high) {
+            const usize mid = (low + high) / 2;
+
+            if (specials[mid].point < point) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+
+        return specials[low];
+    }
+
+    enum class Mode : u8 { Lower, Upper, Title, Fold };
+
+    /// \brief the full mapping of `point` in `mode` into `out`, returns how many code points.
+    constexpr usize map(char32_t point, Mode mode, char32_t (&out)[3]) noexcept {
+        const Record &record = lookup(point);
+
+        if ((record.flags & special) != 0) {
+            const Special  &full   = special_of(point);
+            const char32_t *mapped = mode == Mode::Lower   ? full.lower
+                                     : mode == Mode::Upper ? full.upper
+                                     : mode == Mode::Title ? full.title
+                                                           : full.fold;
+            usize count = 0;
+            while (count < 3 && mapped[count] != 0) {
+                out[count] = mapped[count];
+                ++count;
+            }
+
+            return count;
+        }
+
+        const i32 delta = mode == Mode::Lower   ? record.lower
+                          : mode == Mode::Upper ? record.upper
+                          : mode == Mode::Title ? record.title
+                                                : record.fold;
+
+        out[0] = static_cast<char32_t>(static_cast<i32>(point) + delta);
+        return 1;
+    }
+
+    namespace scalar {
+        inline usize ascii_case(const char *src, usize count, char *dst, char from) noexcept {
+            usize done = 0;
+
+            for (; done < count; ++done) {
+                const auto chr = static_cast<unsigned char>(src[done]);
+
+                if (chr >= 0x80) {
+                    break;
+                }
+
+                dst[done] = static_cast<char>(static_cast<unsigned char>(chr - from) < 26 ? chr ^ 0x20 : chr);
+            }
+
+            return done;
+        }
+
+        inline usize ascii_equal_fold(const char *lhs, const char *rhs, usize count) noexcept {
+            usize done = 0;
+
+            for (; done < count; ++done) {
+                const auto left  = static_cast<unsigned char>(lhs[done]);
+                const auto right = static_cast<unsigned char>(rhs[done]);
+
+                if ((left | right) >= 0x80) {
+                    break;
+                }
+
+                if (left != right && ((left ^ 0x20) != right || static_cast<unsigned char>((left | 0x20) - 'a') >= 26)) {
+                    break;
+                }
+            }
+
+            return done;
+        }
+    }  // namespace scalar
+
+#ifdef H_SIMD_X86
+    namespace ssse3 {
+        using Lanes = _unicode::ssse3::Lanes;
+
+#define H_KERNEL_TARGET H_TARGET("ssse3")
+#include "casing.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace ssse3
+
+    namespace avx2 {
+        using Lanes = _unicode::avx2::Lanes;
+
+#define H_KERNEL_TARGET H_TARGET("avx2")
+#include "casing.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace avx2
+#endif
+
+    inline usize ascii_case(const char *src, usize count, char *dst, char from) noexcept {
+#ifdef H_SIMD_X86
+        switch (_unicode::level()) {
+            case _unicode::Level::AVX2:
+                return avx2::ascii_case(src, count, dst, from);
+            case _unicode::Level::SSSE3:
+                return ssse3::ascii_case(src, count, dst, from);
+            default:
+                break;
+        }
+#endif
+        return scalar::ascii_case(src, count, dst, from);
+    }
+
+    inline usize ascii_equal_fold(const char *lhs, const char *rhs, usize count) noexcept {
+#ifdef H_SIMD_X86
+        switch (_unicode::level()) {
+            case _unicode::Level::AVX2:
+                return avx2::ascii_equal_fold(lhs, rhs, count);
+            case _unicode::Level::SSSE3:
+                return ssse3::ascii_equal_fold(lhs, rhs, count);
+            default:
+                break;
+        }
+#endif
+        return scalar::ascii_equal_fold(lhs, rhs, count);
+    }
+
+    /// \struct Mapper
+    ///
+    /// Case maps UTF-8 into a caller buffer in resumable steps. Runs of ASCII go through the
+    /// vector kernels, or a branch free byte loop for title case (whose letters depend on the one
+    /// before), everything else one code point at a time through the tables; malformed bytes are
+    /// copied through unchanged.
+    struct Mapper {
+        Mode mode;
+        bool capitalize = false;  // title case the first code point only, lower case the rest
+        bool previous   = false;  // title: the previous code point was cased; capitalize: past the first
+
+        /// title case the ASCII run at `src`; branch free, as the case of the letters in running
+        /// text is not predictable.
+        void title_ascii(const char *&src, const char *last, char *&dst, char *end) noexcept {
+            while (src != last && dst != end) {
+                const auto chr = static_cast<unsigned char>(*src);
+
+                if (chr >= 0x80) {
+                    break;
+                }
+
+                const bool letter = static_cast<unsigned char>((chr | 0x20) - 'a') < 26;
+                const auto cased  = static_cast<unsigned char>((chr & 0xDF) | (static_cast<unsigned>(previous) << 5));
+                const auto keep   = static_cast<unsigned char>(-static_cast<int>(letter));
+
+                *dst++   = static_cast<char>(chr ^ ((chr ^ cased) & keep));
+                previous = letter;
+                ++src;
+            }
+        }
+
+        /// map from `src` into `[dst, end)` until the input is done or the output is nearly full
+        /// (one code point needs at most 12 bytes), returns the new end of the output.
+        char *run(const char *&src, const char *last, char *dst, char *end) {
+            while (src != last && end - dst >= 12) {
+                if (mode != Mode::Title || (capitalize && previous)) {
+                    const usize room  = static_cast<usize>(end - dst);
+                    const usize avail = static_cast<usize>(last - src);
+                    const usize done  = ascii_case(src, avail < room ? avail : room, dst, mode == Mode::Upper ? 'a' : 'A');
+
+                    src += done;
+                    dst += done;
+
+                    if (src == last || end - dst < 12) {
+                        break;
+                    }
+                }
+
+                if (mode == Mode::Title && !capitalize) {
+                    title_ascii(src, last, dst, end);
+
+                    if (src == last || end - dst < 12) {
+                        break;
+                    }
+                }
+
+                const _unicode::Step step = _unicode::read(src, last);
+
+                if (step.error != Unicode::Error::None) {
+                    *dst++ = *src++;
+                    continue;
+                }
+
+                char32_t mapped[3];
+                usize    count = 0;
+
+                if (capitalize) {
+                    count    = map(step.point, previous ? Mode::Lower : Mode::Title, mapped);
+                    previous = true;
+                } else if (mode == Mode::Title) {
+                    count    = map(step.point, previous ? Mode::Lower : Mode::Title, mapped);
+                    previous = (lookup(step.point).flags & cased) != 0;
+                } else {
+                    count = map(step.point, mode, mapped);
+                }
+
+                for (usize i = 0; i < count; ++i) {
+                    dst += _unicode::write(mapped[i], dst);
+                }
+
+                src += step.length;
+            }
+
+            return dst;
+        }
+    };
+
+    template <usize _SlabSize>
+    basic<char, _SlabSize> convert(const char *first, const char *last, Mapper mapper) {
+        basic<char, _SlabSize> result;
+
+        const usize size    = static_cast<usize>(last - first);
+        usize       bound   = size + size / 8 + 16;
+        usize       written = 0;
+
+        while (true) {
+            result.resize_and_overwrite(bound, [&](char *dest, usize capacity) {
+                written = static_cast<usize>(mapper.run(first, last, dest + written, dest + capacity) - dest);
+                return written;
+            });
+
+            if (first == last) {
+                return result;
+            }
+
+            bound *= 2;  // only when the text grew, e.g. many 'ß' upper cased to "SS"
+        }
+    }
+
+    /// \struct Folded
+    /// Reads a UTF-8 string as a stream of case folded code points.
+    struct Folded {
+        const char *src;
+        const char *last;
+        char32_t    pending[3] = {};
+        usize       count      = 0;
+        usize       next       = 0;
+
+        [[nodiscard]] bool idle() const noexcept { return next == count; }
+        [[nodiscard]] bool done() const noexcept { return idle() && src == last; }
+
+        char32_t pop() noexcept {
+            if (idle()) {
+                const _unicode::Step step = _unicode::read(src, last);
+
+                if (step.error != Unicode::Error::None) {
+                    // a malformed byte only equals itself, kept apart from every code point
+                    pending[0] = 0x110000 + static_cast<unsigned char>(*src++);
+                    count      = 1;
+                } else {
+                    count = map(step.point, Mode::Fold, pending);
+                    src += step.length;
+                }
+
+                next = 0;
+            }
+
+            return pending[next++];
+        }
+    };
+
+    inline int compare_fold(const char *lhs, const char *lhs_last, const char *rhs, const char *rhs_last) noexcept {
+        Folded left{lhs, lhs_last};
+        Folded right{rhs, rhs_last};
+
+        while (true) {
+            if (left.idle() && right.idle()) {
+                const usize left_size  = static_cast<usize>(left.last - left.src);
+                const usize right_size = static_cast<usize>(right.last - right.src);
+                const usize same       = ascii_equal_fold(left.src, right.src, left_size < right_size ? left_size : right_size);
+
+                left.src += same;
+                right.src += same;
+            }
+
+            if (left.done() || right.done()) {
+                return left.done() ? (right.done() ? 0 : -1) : 1;
+            }
+
+            const char32_t a = left.pop();
+            const char32_t b = right.pop();
+
+            if (a != b) {
+                return a < b ? -1 : 1;
+            }
+        }
+    }
+
+    template <typename Text>
+    concept Utf8 = _unicode::Encoded<Text> && sizeof(_unicode::unit_of<Text>) == 1;
+
+    template <typename Text>
+    const char *begin_of(const Text &text) noexcept {
+        return reinterpret_cast<const char *>(text.data());
+    }
+
+    template <typename Text>
+    const char *end_of(const Text &text) noexcept {
+        return reinterpret_cast<const char *>(text.data()) + text.size();
+    }
+}  // namespace _casing
+
+namespace Unicode {
+    /// \include belongs to the helix standard library.
+    /// \brief the simple (one to one) case mappings of a single code point, code points without
+    /// one map to themselves.
+    constexpr char32_t to_lower(char32_t point) noexcept {
+        return static_cast<char32_t>(static_cast<i32>(point) + _casing::lookup(point).lower);
+    }
+
+    constexpr char32_t to_upper(char32_t point) noexcept {
+        return static_cast<char32_t>(static_cast<i32>(point) + _casing::lookup(point).upper);
+    }
+
+    constexpr char32_t to_title(char32_t point) noexcept {
+        return static_cast<char32_t>(static_cast<i32>(point) + _casing::lookup(point).title);
+    }
+
+    constexpr char32_t fold_case(char32_t point) noexcept {
+        return static_cast<char32_t>(static_cast<i32>(point) + _casing::lookup(point).fold);
+    }
+
+    /// the Unicode Cased property: letters with case, and a few symbols that behave like them.
+    constexpr bool is_cased(char32_t point) noexcept { return (_casing::lookup(point).flags & _casing::cased) != 0; }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` in lower case, with the full mappings (`İ` becomes `i̇`).
+    ///
+    /// ASCII is converted a vector register at a time, everything else through two stage tables
+    /// built at compile time. malformed bytes are kept as they are. the context dependent rules
+    /// of SpecialCasing (final sigma, locale rules) are not applied.
+    template <usize _SlabSize = 16, typename Text>
+        requires _casing::Utf8<Text>
+    basic<char, _SlabSize> lower(const Text &text) {
+        return _casing::convert<_SlabSize>(_casing::begin_of(text), _casing::end_of(text), {_casing::Mode::Lower});
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` in upper case, with the full mappings (`ß` becomes `SS`).
+    template <usize _SlabSize = 16, typename Text>
+        requires _casing::Utf8<Text>
+    basic<char, _SlabSize> upper(const Text &text) {
+        return _casing::convert<_SlabSize>(_casing::begin_of(text), _casing::end_of(text), {_casing::Mode::Upper});
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` with every word title cased: a code point that follows a cased one is
+    /// lower cased, any other is title cased.
+    template <usize _SlabSize = 16, typename Text>
+        requires _casing::Utf8<Text>
+    basic<char, _SlabSize> title(const Text &text) {
+        return _casing::convert<_SlabSize>(_casing::begin_of(text), _casing::end_of(text), {_casing::Mode::Title});
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` with its first code point title cased and the rest lower cased.
+    template <usize _SlabSize = 16, typename Text>
+        requires _casing::Utf8<Text>
+    basic<char, _SlabSize> capitalize(const Text &text) {
+        return _casing::convert<_SlabSize>(_casing::begin_of(text), _casing::end_of(text), {_casing::Mode::Title, true});
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` case folded (full folding, `ß` becomes `ss`), for caseless matching.
+    template <usize _SlabSize = 16, typename Text>
+        requires _casing::Utf8<Text>
+    basic<char, _SlabSize> casefold(const Text &text) {
+        return _casing::convert<_SlabSize>(_casing::begin_of(text), _casing::end_of(text), {_casing::Mode::Fold});
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief three way compare of two UTF-8 strings by their case folded code points, without
+    /// building the folded strings.
+    ///
+    /// common ASCII prefixes are compared a vector register at a time; `equal_fold("Straße",
+    /// "STRASSE")` holds.
+    template <typename Lhs, typename Rhs>
+        requires(_casing::Utf8<Lhs> && _casing::Utf8<Rhs>)
+    int compare_fold(const Lhs &lhs, const Rhs &rhs) noexcept {
+        return _casing::compare_fold(_casing::begin_of(lhs), _casing::end_of(lhs), _casing::begin_of(rhs), _casing::end_of(rhs));
+    }
+
+    template <typename Lhs, typename Rhs>
+        requires(_casing::Utf8<Lhs> && _casing::Utf8<Rhs>)
+    bool equal_fold(const Lhs &lhs, const Rhs &rhs) noexcept {
+        return compare_fold(lhs, rhs) == 0;
+    }
+}  // namespace Unicode
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
@@ -0,0 +1,612 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_COMPACT__
+#define __$LIBHELIX_STRING_COMPACT__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../../print/buffer.h"
+#include "../errors.h"
+#include "../string.hh"
+#include "unicode.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+/// \class compact
+///
+/// A string of code points stored at the narrowest width that holds its widest character:
+/// one byte per character for Latin-1 text (which includes all ASCII), two for the rest of the
+/// BMP and four only when something outside it is present. Indexing stays O(1), and typical
+/// text takes a quarter of the memory of a `wchar_t` string.
+///
+/// ### Design Details
+/// - **Width**: picked once from the input (the largest UTF-8 lead byte, UTF-16 surrogates, or
+///   the largest UTF-32 unit; a vectorizable max over the input) and only ever grows, when a
+///   wider character is appended the whole string is re-encoded once at the new width.
+/// - **Storage**: up to 16 bytes are kept inline (16 Latin-1, 8 UCS-2 or 4 UCS-4 characters),
+///   longer strings are a single heap block grown geometrically.
+/// - **Typed access**: `visit(fn)` calls `fn` with a `slice` of `u8`, `char16_t` or `char32_t`
+///   over the characters, so algorithms run on the real width instead of per-character
+///   switches; `find` and friends use it to reach the byte kernels for Latin-1 text.
+/// - **Encoding**: constructing from UTF-8, UTF-16 or UTF-32 validates the input (`RuntimeError`
+///   on malformed text); `encode<CharT>()` and formatting produce UTF-8 (or any other encoding)
+///   again through `String::Unicode`.
+class compact {
+  public:
+    enum Width : u8 { Latin1 = 1, UCS2 = 2, UCS4 = 4 };
+
+    using value_type = char32_t;
+    using size_type  = usize;
+
+    static constexpr size_type npos         = static_cast<size_type>(-1);
+    static constexpr size_type inline_bytes = 16;
+
+    /// \class const_iterator
+    /// Random access iterator yielding code points by value.
+    class const_iterator {
+      public:
+        using iterator_category = LIBCXX_NAMESPACE::random_access_iterator_tag;
+        using value_type        = char32_t;
+        using difference_type   = isize;
+        using pointer           = void;
+        using reference         = char32_t;
+
+        const_iterator() noexcept = default;
+        const_iterator(const compact *str, size_type pos) noexcept
+            : m_str(str)
+            , m_pos(pos) {}
+
+        char32_t operator*() const noexcept { return (*m_str)[m_pos]; }
+        char32_t operator[](difference_type offset) const noexcept {
+            return (*m_str)[static_cast<size_type>(static_cast<difference_type>(m_pos) + offset)];
+        }
+
+        const_iterator &operator++() noexcept {
+            ++m_pos;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept { return {m_str, m_pos++}; }
+        const_iterator &operator--() noexcept {
+            --m_pos;
+            return *this;
+        }
+        const_iterator operator--(int) noexcept { return {m_str, m_pos--}; }
+
+        const_iterator &operator+=(difference_type offset) noexcept {
+            m_pos = static_cast<size_type>(static_cast<difference_type>(m_pos) + offset);
+            return *this;
+        }
+        const_iterator &operator-=(difference_type offset) noexcept { return *this += -offset; }
+
+        friend const_iterator operator+(const_iterator it, difference_type offset) noexcept { return it += offset; }
+        friend const_iterator operator+(difference_type offset, const_iterator it) noexcept { return it += offset; }
+        friend const_iterator operator-(const_iterator it, difference_type offset) noexcept { return it -= offset; }
+        friend difference_type operator-(const const_iterator &lhs, const const_iterator &rhs) noexcept {
+            return static_cast<difference_type>(lhs.m_pos) - static_cast<difference_type>(rhs.m_pos);
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept { return lhs.m_pos == rhs.m_pos; }
+        friend auto operator<=>(const const_iterator &lhs, const const_iterator &rhs) noexcept { return lhs.m_pos <=> rhs.m_pos; }
+
+      private:
+        const compact *m_str = nullptr;
+        size_type      m_pos = 0;
+    };
+
+    compact() noexcept = default;
+
+    /// decode UTF-8, UTF-16 or UTF-32 text (picked by the size of its character type).
+    template <typename Text>
+        requires _unicode::Encoded<Text>
+    explicit compact(const Text &text) {
+        assign(text.data(), text.data() + text.size());
+    }
+
+    explicit compact(const char *str)
+        : compact(slice<char>(str, LIBCXX_NAMESPACE::strlen(str))) {}
+
+    compact(const compact &other) { copy_from(other); }
+
+    compact(compact &&other) noexcept
+        : m_storage(other.m_storage)
+        , m_size(other.m_size)
+        , m_width(other.m_width)
+        , m_heap(other.m_heap) {
+        other.reset();
+    }
+
+    compact &operator=(const compact &other) {
+        if (this != &other) {
+            release();
+            reset();
+            copy_from(other);
+        }
+
+        return *this;
+    }
+
+    compact &operator=(compact &&other) noexcept {
+        if (this != &other) {
+            release();
+
+            m_storage = other.m_storage;
+            m_size    = other.m_size;
+            m_width   = other.m_width;
+            m_heap    = other.m_heap;
+
+            other.reset();
+        }
+
+        return *this;
+    }
+
+    ~compact() { release(); }
+
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+    [[nodiscard]] size_type length() const noexcept { return m_size; }
+    [[nodiscard]] bool      empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] Width     width() const noexcept { return m_width; }
+
+    /// characters that fit without reallocating, at the current width.
+    [[nodiscard]] size_type capacity() const noexcept { return (m_heap ? m_storage.heap.capacity : inline_bytes) / m_width; }
+
+    /// the storage in use, `size() * width()` bytes.
+    [[nodiscard]] const u8 *bytes() const noexcept { return m_heap ? m_storage.heap.ptr : m_storage.local; }
+
+    char32_t operator[](size_type pos) const noexcept {
+        switch (m_width) {
+            case Latin1:
+                return bytes()[pos];
+            case UCS2:
+                return reinterpret_cast<const char16_t *>(bytes())[pos];
+            default:
+                return reinterpret_cast<const char32_t *>(bytes())[pos];
+        }
+    }
+
+    char32_t at(size_type pos) const {
+        if (pos >= m_size) {
+            throw H_STD_NAMESPACE::errors::RuntimeError("compact string index out of range.");
+        }
+
+        return (*this)[pos];
+    }
+
+    char32_t front() const noexcept { return (*this)[0]; }
+    char32_t back() const noexcept { return (*this)[m_size - 1]; }
+
+    [[nodiscard]] const_iterator begin() const noexcept { return {this, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return {this, m_size}; }
+
+    /// \brief call `fn` with the characters as a `slice<u8>`, `slice<char16_t>` or
+    /// `slice<char32_t>`, whichever matches the current width.
+    template <typename Fn>
+    decltype(auto) visit(Fn &&fn) const {
+        switch (m_width) {
+            case Latin1:
+                return fn(slice<u8>(bytes(), m_size));
+            case UCS2:
+                return fn(slice<char16_t>(reinterpret_cast<const char16_t *>(bytes()), m_size));
+            default:
+                return fn(slice<char32_t>(reinterpret_cast<const char32_t *>(bytes()), m_size));
+        }
+    }
+
+    [[nodiscard]] size_type find(char32_t chr, size_type from = 0) const noexcept {
+        if (width_of(chr) > m_width) {
+            return npos;  // wider than anything stored
+        }
+
+        return visit([&](auto view) {
+            using Unit = typename decltype(view)::value_type;
+            return view.find(static_cast<Unit>(chr), from);
+        });
+    }
+
+    [[nodiscard]] size_type count(char32_t chr) const noexcept {
+        if (width_of(chr) > m_width) {
+            return 0;
+        }
+
+        return visit([&](auto view) {
+            using Unit = typename decltype(view)::value_type;
+            return view.count(static_cast<Unit>(chr));
+        });
+    }
+
+    [[nodiscard]] bool contains(char32_t chr) const noexcept { return find(chr) != npos; }
+
+    void reserve(size_type count) {
+        if (count > capacity()) {
+            relocate(m_width, count);
+        }
+    }
+
+    void clear() noexcept { m_size = 0; }
+
+    /// append one code point, re-encoding the string first if it needs a wider width. throws
+    /// `RuntimeError` for a surrogate or a value above U+10FFFF, as the constructors do.
+    void push_back(char32_t chr) {
+        if ((chr & 0xFFFFF800) == 0xD800 || chr > 0x10FFFF) {
+            const Unicode::Error error = chr > 0x10FFFF ? Unicode::Error::TooLarge : Unicode::Error::Surrogate;
+            throw H_STD_NAMESPACE::errors::RuntimeError(H_NAMESPACE::string("malformed unicode, ") +
+                                                        Unicode::describe(error) + ".");
+        }
+
+        const Width needed = width_of(chr);
+
+        if (needed > m_width || m_size == capacity()) {
+            relocate(needed > m_width ? needed : m_width, grown(m_size + 1));
+        }
+
+        store(m_size++, chr);
+    }
+
+    compact &append(const compact &other) {
+        const Width     needed = other.m_width > m_width ? other.m_width : m_width;
+        const size_type size   = m_size + other.m_size;
+
+        if (needed > m_width || size > capacity()) {
+            relocate(needed, grown(size));
+        }
+
+        other.visit([&](auto view) { widen(view.data(), view.size(), mutable_bytes() + m_size * m_width, m_width); });
+        m_size = size;
+
+        return *this;
+    }
+
+    compact &operator+=(const compact &other) { return append(other); }
+    compact &operator+=(char32_t chr) {
+        push_back(chr);
+        return *this;
+    }
+
+    /// remove the last character, the width is kept.
+    void pop() noexcept {
+        if (m_size != 0) {
+            --m_size;
+        }
+    }
+
+    /// \brief the text in another encoding, `encode<char>()` for UTF-8.
+    template <typename CharT, usize _SlabSize = 16>
+        requires _unicode::Unit<CharT>
+    [[nodiscard]] basic<CharT, _SlabSize> encode() const {
+        if (m_width == UCS2) {
+            return Unicode::transcode<CharT, _SlabSize>(slice<char16_t>(reinterpret_cast<const char16_t *>(bytes()), m_size));
+        }
+
+        if (m_width == UCS4) {
+            return Unicode::transcode<CharT, _SlabSize>(slice<char32_t>(reinterpret_cast<const char32_t *>(bytes()), m_size));
+        }
+
+        const u8               *chars = bytes();
+        basic<CharT, _SlabSize> result;
+
+        if constexpr (sizeof(CharT) == 1) {
+            size_type high = 0;
+            for (size_type i = 0; i < m_size; ++i) {  // vectorized by the compiler
+                high += static_cast<size_type>(chars[i] >= 0x80);
+            }
+
+            result.resize_and_overwrite(m_size + high, [&](CharT *dest, usize) {
+                return static_cast<usize>(latin1_to_utf8(chars, m_size, dest) - dest);
+            });
+        } else {
+            result.resize_and_overwrite(m_size, [&](CharT *dest, usize) {
+                for (size_type i = 0; i < m_size; ++i) {
+                    dest[i] = static_cast<CharT>(chars[i]);
+                }
+
+                return m_size;
+            });
+        }
+
+        return result;
+    }
+
+    /// three way compare by code point, the same order as comparing the UTF-8 or UTF-32 bytes.
+    [[nodiscard]] int compare(const compact &other) const noexcept {
+        if (m_width == other.m_width && m_width == Latin1) {
+            const size_type common = m_size < other.m_size ? m_size : other.m_size;
+            const int       order  = common == 0 ? 0 : LIBCXX_NAMESPACE::memcmp(bytes(), other.bytes(), common);
+
+            return order != 0 ? order : (m_size < other.m_size ? -1 : m_size > other.m_size ? 1 : 0);
+        }
+
+        const size_type common = m_size < other.m_size ? m_size : other.m_size;
+
+        for (size_type i = 0; i < common; ++i) {
+            const char32_t lhs = (*this)[i];
+            const char32_t rhs = other[i];
+
+            if (lhs != rhs) {
+                return lhs < rhs ? -1 : 1;
+            }
+        }
+
+        return m_size < other.m_size ? -1 : m_size > other.m_size ? 1 : 0;
+    }
+
+    /// equal widths compare with one `memcmp`.
+    friend bool operator==(const compact &lhs, const compact &rhs) noexcept {
+        if (lhs.m_size != rhs.m_size) {
+            return false;
+        }
+
+        if (lhs.m_width == rhs.m_width) {
+            return lhs.m_size == 0 || LIBCXX_NAMESPACE::memcmp(lhs.bytes(), rhs.bytes(), lhs.m_size * lhs.m_width) == 0;
+        }
+
+        return lhs.compare(rhs) == 0;
+    }
+    friend bool operator!=(const compact &lhs, const compact &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator<(const compact &lhs, const compact &rhs) noexcept { return lhs.compare(rhs) < 0; }
+    friend bool operator<=(const compact &lhs, const compact &rhs) noexcept { return lhs.compare(rhs) <= 0; }
+    friend bool operator>(const compact &lhs, const compact &rhs) noexcept { return lhs.compare(rhs) > 0; }
+    friend bool operator>=(const compact &lhs, const compact &rhs) noexcept { return lhs.compare(rhs) >= 0; }
+
+    /// written as UTF-8, a chunk at a time through a small stack buffer.
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const {
+        constexpr size_type chunk = 64;
+
+        char      buffer[chunk * 4];
+        size_type done = 0;
+
+        while (done < m_size) {
+            const size_type count = m_size - done < chunk ? m_size - done : chunk;
+
+            const usize written = visit([&](auto view) -> usize {
+                const auto *first = view.data() + done;
+
+                if constexpr (sizeof(*first) == 1) {
+                    return static_cast<usize>(latin1_to_utf8(first, count, buffer) - buffer);
+                } else {
+                    return _unicode::convert(first, first + count, buffer).written;
+                }
+            });
+
+            out.append(buffer, written);
+            done += count;
+        }
+    }
+
+  private:
+    union Storage {
+        alignas(4) u8 local[inline_bytes];
+
+        struct {
+            u8       *ptr;
+            size_type capacity;  // bytes
+        } heap;
+    };
+
+    static Width width_of(char32_t chr) noexcept { return chr <= 0xFF ? Latin1 : chr <= 0xFFFF ? UCS2 : UCS4; }
+
+    /// the narrowest width for valid text. branch free maxima, vectorized by the compiler.
+    template <typename CharT>
+    static Width widest(const CharT *first, const CharT *last) noexcept {
+        u32 most = 0;
+        u32 pair = 0;
+
+        for (; first != last; ++first) {
+            const u32 unit = _unicode::value(*first);
+
+            most = unit > most ? unit : most;
+
+            if constexpr (sizeof(CharT) == 2) {
+                pair |= static_cast<u32>((unit & 0xF800) == 0xD800);
+            }
+        }
+
+        if constexpr (sizeof(CharT) == 1) {
+            return most <= 0xC3 ? Latin1 : most < 0xF0 ? UCS2 : UCS4;  // C2 and C3 lead U+0080..U+00FF
+        } else {
+            return pair != 0 ? UCS4 : width_of(static_cast<char32_t>(most));
+        }
+    }
+
+    /// UTF-8 from Latin-1, two bytes for every character above 0x7F.
+    template <typename CharT>
+    static CharT *latin1_to_utf8(const u8 *chars, size_type count, CharT *dest) noexcept {
+        for (size_type i = 0; i < count; ++i) {
+            const u32 chr = chars[i];
+
+            if (chr < 0x80) {
+                *dest++ = static_cast<CharT>(chr);
+            } else {
+                *dest++ = static_cast<CharT>(0xC0 | (chr >> 6));
+                *dest++ = static_cast<CharT>(0x80 | (chr & 0x3F));
+            }
+        }
+
+        return dest;
+    }
+
+    /// copy `count` units into storage of `width` bytes per character, widening as needed.
+    template <typename Unit>
+    static void widen(const Unit *src, size_type count, u8 *dest, Width width) noexcept {
+        if (count == 0) {
+            return;
+        }
+
+        if (sizeof(Unit) == width) {
+            LIBCXX_NAMESPACE::memcpy(dest, src, count * sizeof(Unit));
+            return;
+        }
+
+        switch (width) {  // plain loops, vectorized by the compiler
+            case Latin1:
+                for (size_type i = 0; i < count; ++i) {
+                    dest[i] = static_cast<u8>(src[i]);
+                }
+                break;
+            case UCS2:
+                for (size_type i = 0; i < count; ++i) {
+                    reinterpret_cast<char16_t *>(dest)[i] = static_cast<char16_t>(src[i]);
+                }
+                break;
+            default:
+                for (size_type i = 0; i < count; ++i) {
+                    reinterpret_cast<char32_t *>(dest)[i] = static_cast<char32_t>(_unicode::value(src[i]));
+                }
+                break;
+        }
+    }
+
+    template <typename CharT>
+    void assign(const CharT *first, const CharT *last) {
+        const Unicode::Result status = _unicode::validate(first, last);
+
+        if (!status.ok()) {
+            throw H_STD_NAMESPACE::errors::RuntimeError(H_NAMESPACE::string("malformed unicode, ") +
+                                                        Unicode::describe(status.error) + ".");
+        }
+
+        const size_type units = static_cast<size_type>(last - first);
+        const Width     width = widest(first, last);
+        const size_type count = sizeof(CharT) == 4 ? units : _unicode::length<char32_t>(first, last);
+
+        relocate(width, count);
+        u8 *dest = mutable_bytes();
+
+        if constexpr (sizeof(CharT) == 1) {
+            if (width == Latin1) {
+                if (count == units) {
+                    widen(first, units, dest, Latin1);  // ASCII, a plain copy
+                } else {
+                    for (const CharT *src = first; src != last; ++dest) {  // only C2 and C3 leads
+                        const u32 lead = _unicode::value(*src++);
+                        *dest = static_cast<u8>(lead < 0x80 ? lead : ((lead & 0x1F) << 6) | (_unicode::value(*src++) & 0x3F));
+                    }
+                }
+
+                m_size = count;
+                return;
+            }
+        }
+
+        if (sizeof(CharT) == 1 || (sizeof(CharT) == 2 && width == UCS4)) {
+            m_size = width == UCS2 ? _unicode::convert(first, last, reinterpret_cast<char16_t *>(dest)).written
+                                   : _unicode::convert(first, last, reinterpret_cast<char32_t *>(dest)).written;
+            return;
+        }
+
+        widen(first, units, dest, width);  // UTF-16 without pairs and UTF-32 are already code points
+        m_size = units;
+    }
+
+    void copy_from(const compact &other) {
+        if (other.m_size * other.m_width > inline_bytes) {
+            m_storage.heap = {static_cast<u8 *>(::operator new(other.m_size * other.m_width)), other.m_size * other.m_width};
+            m_heap         = true;
+        }
+
+        m_width = other.m_width;
+        m_size  = other.m_size;
+
+        if (m_size != 0) {
+            LIBCXX_NAMESPACE::memcpy(mutable_bytes(), other.bytes(), m_size * m_width);
+        }
+    }
+
+    [[nodiscard]] size_type grown(size_type required) const noexcept {
+        const size_type doubled = capacity() * 2;
+        return doubled > required ? doubled : required;
+    }
+
+    u8 *mutable_bytes() noexcept { return m_heap ? m_storage.heap.ptr : m_storage.local; }
+
+    void store(size_type pos, char32_t chr) noexcept {
+        switch (m_width) {
+            case Latin1:
+                mutable_bytes()[pos] = static_cast<u8>(chr);
+                break;
+            case UCS2:
+                reinterpret_cast<char16_t *>(mutable_bytes())[pos] = static_cast<char16_t>(chr);
+                break;
+            default:
+                reinterpret_cast<char32_t *>(mutable_bytes())[pos] = chr;
+                break;
+        }
+    }
+
+    /// move the characters into storage for `count` characters of `width`, widening them.
+    void relocate(Width width, size_type count) {
+        const size_type bytes = count * width;
+
+        if (bytes <= inline_bytes && !m_heap) {
+            if (width != m_width && m_size != 0) {
+                u8 copy[inline_bytes];
+                LIBCXX_NAMESPACE::memcpy(copy, m_storage.local, m_size * m_width);
+
+                visit_units(copy, [&](const auto *units) { widen(units, m_size, m_storage.local, width); });
+            }
+
+            m_width = width;
+            return;
+        }
+
+        u8 *block = static_cast<u8 *>(::operator new(bytes > inline_bytes ? bytes : inline_bytes));
+
+        visit_units(this->bytes(), [&](const auto *units) { widen(units, m_size, block, width); });
+        release();
+
+        m_storage.heap = {block, bytes > inline_bytes ? bytes : inline_bytes};
+        m_heap         = true;
+        m_width        = width;
+    }
+
+    template <typename Fn>
+    void visit_units(const u8 *chars, Fn &&fn) const {
+        switch (m_width) {
+            case Latin1:
+                fn(chars);
+                break;
+            case UCS2:
+                fn(reinterpret_cast<const char16_t *>(chars));
+                break;
+            default:
+                fn(reinterpret_cast<const char32_t *>(chars));
+                break;
+        }
+    }
+
+    void release() noexcept {
+        if (m_heap) {
+            ::operator delete(m_storage.heap.ptr);
+        }
+    }
+
+    void reset() noexcept {
+        m_size  = 0;
+        m_width = Latin1;
+        m_heap  = false;
+    }
+
+    Storage   m_storage{};
+    size_type m_size  = 0;
+    Width     m_width = Latin1;
+    bool      m_heap  = false;
+};
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
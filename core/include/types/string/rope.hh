@@ -0,0 +1,413 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_ROPE__
+#define __$LIBHELIX_STRING_ROPE__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../../print/buffer.h"
+#include "../string.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+/// \class rope
+///
+/// A string built from segments, for code that assembles large text piece by piece. Every
+/// `append` is remembered as its own segment so `pop_segment` can undo it, and nothing is moved
+/// once written, so appending never recopies what is already there.
+///
+/// ### Design Details
+/// - **Chunks**: appended text is copied into the newest chunk; a chunk that is full is left as
+///   is and a new one twice its size is started, so appends are amortized O(1) and a rope of `n`
+///   characters owns O(log n) chunks. String literals are referenced in place, not copied.
+/// - **Segments**: each segment is a `slice` into a chunk (or a literal). `pop_segment` drops the
+///   last one and, when it sits at the end of the newest chunk, hands its bytes back; O(1).
+/// - **Lazy flattening**: `flatten()`, `c_str()` and `as_slice()` need contiguous characters.
+///   When every segment is already adjacent in one chunk nothing is copied. Otherwise all
+///   segments are copied once into a single chunk with room to spare, and the segments are
+///   re-pointed there, so later appends keep the rope contiguous.
+/// - **Zero-copy reads**: iteration, `segments()` and formatting walk the segments directly.
+///
+/// ### Notes
+/// - Flattening is done by const accessors and is not synchronized, a rope shared between
+///   threads must not be read by two of them at once unless it was flattened first.
+template <typename CharT>
+class rope {
+  public:
+    using value_type = CharT;
+    using size_type  = usize;
+
+    static constexpr size_type min_chunk = 64;
+
+    /// \class const_iterator
+    /// Forward iterator over the characters of every segment in order.
+    class const_iterator {
+      public:
+        using iterator_category = LIBCXX_NAMESPACE::forward_iterator_tag;
+        using value_type        = CharT;
+        using difference_type   = isize;
+        using pointer           = const CharT *;
+        using reference         = const CharT &;
+
+        const_iterator() noexcept = default;
+
+        reference operator*() const noexcept { return (*m_segment)[m_pos]; }
+        pointer   operator->() const noexcept { return m_segment->data() + m_pos; }
+
+        const_iterator &operator++() noexcept {
+            if (++m_pos == m_segment->size()) {
+                ++m_segment;
+                m_pos = 0;
+                skip_empty();
+            }
+
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept {
+            const_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) noexcept {
+            return lhs.m_segment == rhs.m_segment && lhs.m_pos == rhs.m_pos;
+        }
+
+      private:
+        friend class rope;
+
+        const_iterator(const slice<CharT> *segment, const slice<CharT> *last) noexcept
+            : m_segment(segment)
+            , m_last(last) {
+            skip_empty();
+        }
+
+        void skip_empty() noexcept {
+            while (m_segment != m_last && m_segment->empty()) {
+                ++m_segment;
+            }
+        }
+
+        const slice<CharT> *m_segment = nullptr;
+        const slice<CharT> *m_last    = nullptr;
+        size_type           m_pos     = 0;
+    };
+
+    rope() = default;
+
+    rope(const rope &other) { copy_from(other); }
+
+    rope(rope &&other) noexcept
+        : m_chunks(LIBCXX_NAMESPACE::move(other.m_chunks))
+        , m_segments(LIBCXX_NAMESPACE::move(other.m_segments))
+        , m_size(other.m_size)
+        , m_contiguous(other.m_contiguous) {
+        other.m_size       = 0;
+        other.m_contiguous = true;
+    }
+
+    rope &operator=(const rope &other) {
+        if (this != &other) {
+            clear();
+            copy_from(other);
+        }
+
+        return *this;
+    }
+
+    rope &operator=(rope &&other) noexcept {
+        if (this != &other) {
+            release();
+
+            m_chunks     = LIBCXX_NAMESPACE::move(other.m_chunks);
+            m_segments   = LIBCXX_NAMESPACE::move(other.m_segments);
+            m_size       = other.m_size;
+            m_contiguous = other.m_contiguous;
+
+            other.m_size       = 0;
+            other.m_contiguous = true;
+        }
+
+        return *this;
+    }
+
+    ~rope() { release(); }
+
+    /// append a copy of `text` as a new segment.
+    rope &append(slice<CharT> text) {
+        CharT *dest = room(text.size());
+
+        if (!text.empty()) {
+            LIBCXX_NAMESPACE::memcpy(dest, text.data(), text.size() * sizeof(CharT));
+        }
+
+        push({dest, text.size()});
+        return *this;
+    }
+
+    /// append a string literal (`"text"_s`) as a new segment without copying it.
+    rope &append(literal<CharT> text) {
+        push({text.data(), text.size()});
+        return *this;
+    }
+
+    /// append a copy of the array up to its first null character.
+    template <usize N>
+    rope &append(const CharT (&array)[N]) {
+        return append(slice<CharT>(array, _string::array_length(array)));
+    }
+
+    rope &operator+=(slice<CharT> text) { return append(text); }
+    rope &operator+=(literal<CharT> text) { return append(text); }
+
+    template <usize N>
+    rope &operator+=(const CharT (&array)[N]) {
+        return append(array);
+    }
+
+    /// remove the most recently appended segment, a no-op on an empty rope.
+    void pop_segment() noexcept {
+        if (m_segments.empty()) {
+            return;
+        }
+
+        give_back(m_segments.back());
+
+        m_size -= m_segments.back().size();
+        m_segments.pop_back();
+
+        if (m_segments.size() <= 1) {
+            m_contiguous = true;
+        }
+    }
+
+    /// remove the last character, the segment it belongs to stays (possibly empty).
+    void pop() noexcept {
+        for (auto seg = m_segments.rbegin(); seg != m_segments.rend(); ++seg) {
+            if (!seg->empty()) {
+                give_back(seg->split(seg->size() - 1));
+                seg->right_strip(1);
+
+                --m_size;
+                return;
+            }
+        }
+    }
+
+    void clear() noexcept {
+        for (Chunk &chunk : m_chunks) {
+            chunk.used = 0;
+        }
+
+        if (m_chunks.size() > 1) {  // keep the largest chunk for reuse
+            release_except_last();
+        }
+
+        m_segments.clear();
+        m_size       = 0;
+        m_contiguous = true;
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return m_size; }
+    [[nodiscard]] size_type length() const noexcept { return m_size; }
+    [[nodiscard]] bool      empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] size_type segment_count() const noexcept { return m_segments.size(); }
+
+    /// the segments in append order, each one a view into the rope.
+    [[nodiscard]] const LIBCXX_NAMESPACE::vector<slice<CharT>> &segments() const noexcept { return m_segments; }
+
+    const_iterator begin() const noexcept { return {m_segments.data(), m_segments.data() + m_segments.size()}; }
+    const_iterator end() const noexcept {
+        return {m_segments.data() + m_segments.size(), m_segments.data() + m_segments.size()};
+    }
+
+    /// \brief the whole rope as one contiguous, null terminated run of characters.
+    ///
+    /// copies only when the segments are not already adjacent, see the class notes. the view is
+    /// valid until the rope is next modified.
+    slice<CharT> flatten() const {
+        if (m_segments.empty()) {
+            return {empty_string(), 0};
+        }
+
+        if (!m_contiguous || !terminated()) {
+            const_cast<rope *>(this)->relayout();
+        }
+
+        return {m_segments.front().data(), m_size};
+    }
+
+    [[nodiscard]] slice<CharT> as_slice() const { return flatten(); }
+    [[nodiscard]] const CharT *c_str() const { return flatten().data(); }
+
+    /// copy the rope into a `basic` string, allocating once.
+    template <usize _SlabSize = 16>
+    [[nodiscard]] basic<CharT, _SlabSize> str() const {
+        basic<CharT, _SlabSize> result;
+        result.reserve(m_size);
+
+        for (const slice<CharT> &seg : m_segments) {
+            result.append(seg.data(), seg.size());
+        }
+
+        return result;
+    }
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const
+        requires(std::Meta::same_as<CharT, char>)
+    {
+        for (const slice<CharT> &seg : m_segments) {
+            out.append(seg.data(), seg.size());
+        }
+    }
+
+  private:
+    struct Chunk {
+        CharT    *data;
+        size_type capacity;
+        size_type used;
+    };
+
+    static const CharT *empty_string() noexcept {
+        static constexpr CharT empty[1] = {CharT()};
+        return empty;
+    }
+
+    static CharT *allocate(size_type capacity) {
+        return static_cast<CharT *>(::operator new(capacity * sizeof(CharT)));
+    }
+
+    /// space for `count` characters (plus a spare one for a terminator) at the end of the newest
+    /// chunk, starting a new chunk when it does not fit.
+    CharT *room(size_type count) {
+        if (m_chunks.empty() || m_chunks.back().capacity - m_chunks.back().used < count + 1) {
+            size_type capacity = m_chunks.empty() ? min_chunk : m_chunks.back().capacity * 2;
+            capacity           = capacity < count + 1 ? count + 1 : capacity;
+
+            m_chunks.push_back({allocate(capacity), capacity, 0});
+        }
+
+        Chunk &chunk = m_chunks.back();
+        CharT *dest  = chunk.data + chunk.used;
+
+        chunk.used += count;
+        return dest;
+    }
+
+    void push(slice<CharT> seg) {
+        if (!m_segments.empty()) {
+            const slice<CharT> &last = m_segments.back();
+            m_contiguous             = m_contiguous && last.data() + last.size() == seg.data();
+        }
+
+        m_segments.push_back(seg);
+        m_size += seg.size();
+    }
+
+    /// return the characters of `seg` to the newest chunk when they are its last characters.
+    void give_back(slice<CharT> seg) noexcept {
+        if (m_chunks.empty() || seg.empty()) {
+            return;
+        }
+
+        Chunk &chunk = m_chunks.back();
+        if (seg.data() + seg.size() == chunk.data + chunk.used && seg.data() >= chunk.data) {
+            chunk.used -= seg.size();
+        }
+    }
+
+    /// a contiguous rope can be null terminated in place when its end is the end of its chunk's
+    /// used region. a single literal already is, but past the end of anything else in a chunk
+    /// lies memory `room()` reserved and never wrote, so that is not read.
+    [[nodiscard]] bool terminated() const noexcept {
+        const CharT *end = m_segments.front().data() + m_size;
+
+        if (m_chunks.empty() || end != m_chunks.back().data + m_chunks.back().used) {
+            return m_segments.size() == 1 && !owned(m_segments.front().data()) && *end == CharT();
+        }
+
+        *const_cast<CharT *>(end) = CharT();  // room() always leaves a spare character
+        return true;
+    }
+
+    /// whether `ptr` points into one of the chunks, i.e. is not a literal.
+    [[nodiscard]] bool owned(const CharT *ptr) const noexcept {
+        for (const Chunk &chunk : m_chunks) {
+            if (ptr >= chunk.data && ptr < chunk.data + chunk.capacity) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// copy every segment into one new chunk and re-point the segments there.
+    void relayout() {
+        const size_type capacity = (m_size + 1) * 2 < min_chunk ? min_chunk : (m_size + 1) * 2;
+        CharT          *block    = allocate(capacity);
+        CharT          *dest     = block;
+
+        for (slice<CharT> &seg : m_segments) {
+            if (!seg.empty()) {
+                LIBCXX_NAMESPACE::memcpy(dest, seg.data(), seg.size() * sizeof(CharT));
+            }
+
+            seg   = {dest, seg.size()};
+            dest += seg.size();
+        }
+
+        *dest = CharT();
+
+        release();
+        m_chunks.push_back({block, capacity, m_size});
+        m_contiguous = true;
+    }
+
+    void copy_from(const rope &other) {
+        for (const slice<CharT> &seg : other.m_segments) {
+            append(seg);
+        }
+    }
+
+    void release() noexcept {
+        for (Chunk &chunk : m_chunks) {
+            ::operator delete(chunk.data);
+        }
+
+        m_chunks.clear();
+    }
+
+    void release_except_last() noexcept {
+        for (usize i = 0; i + 1 < m_chunks.size(); ++i) {
+            ::operator delete(m_chunks[i].data);
+        }
+
+        m_chunks.erase(m_chunks.begin(), m_chunks.end() - 1);
+    }
+
+    LIBCXX_NAMESPACE::vector<Chunk>        m_chunks;
+    LIBCXX_NAMESPACE::vector<slice<CharT>> m_segments;
+    size_type                              m_size       = 0;
+    bool                                   m_contiguous = true;
+};
+}  // namespace String
+
+H_NAMESPACE_END
+#endif
@@ -0,0 +1,228 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_SEARCH__
+#define __$LIBHELIX_STRING_SEARCH__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+
+#ifdef H_SIMD_X86
+#include <immintrin.h>
+#endif
+
+H_NAMESPACE_BEGIN
+
+namespace String::_search {
+/// \struct Kernels
+///
+/// The byte search primitives behind `slice::find`, `count`, `contains` and friends, one set per
+/// instruction set. `kernels()` picks the widest set the running CPU supports the first time it is
+/// called; every later call is a load of the cached table.
+///
+/// All kernels take a `[first, last)` range and return `last` (or 0) when nothing is found,
+/// except `match_any`, which reports every byte of a 64 byte window that is one of the `size`
+/// bytes of `set` as a bit (byte `i` is bit `i`).
+struct Kernels {
+    const char *(*find_byte)(const char *first, const char *last, char chr);
+    usize (*count_byte)(const char *first, const char *last, char chr);
+    const char *(*find)(const char *first, const char *last, const char *needle, usize size);
+    u64 (*match_any)(const char *window, const char *set, usize size);
+};
+
+inline constexpr usize window = 64;
+
+namespace scalar {
+    inline const char *find_byte(const char *first, const char *last, char chr) {
+        const void *found = LIBCXX_NAMESPACE::memchr(first, chr, static_cast<usize>(last - first));
+        return found != nullptr ? static_cast<const char *>(found) : last;
+    }
+
+    inline usize count_byte(const char *first, const char *last, char chr) {
+        usize count = 0;
+
+        for (; first != last; ++first) {
+            count += static_cast<usize>(*first == chr);
+        }
+
+        return count;
+    }
+
+    /// `memchr` for the first byte, then compare the rest.
+    inline const char *find(const char *first, const char *last, const char *needle, usize size) {
+        if (size == 0) {
+            return first;
+        }
+
+        while (static_cast<usize>(last - first) >= size) {
+            first = find_byte(first, last - size + 1, needle[0]);
+
+            if (first == last - size + 1) {
+                break;
+            }
+
+            if (LIBCXX_NAMESPACE::memcmp(first + 1, needle + 1, size - 1) == 0) {
+                return first;
+            }
+
+            ++first;
+        }
+
+        return last;
+    }
+
+    inline bool is_any(char chr, const char *set, usize size) {
+        for (usize i = 0; i < size; ++i) {
+            if (set[i] == chr) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline u64 match_any(const char *window, const char *set, usize size) {
+        u64 mask = 0;
+
+        for (usize i = 0; i < _search::window; ++i) {
+            mask |= static_cast<u64>(is_any(window[i], set, size)) << i;
+        }
+
+        return mask;
+    }
+
+    inline const char *find_any(const char *first, const char *last, const char *set, usize size) {
+        while (first != last && !is_any(*first, set, size)) {
+            ++first;
+        }
+
+        return first;
+    }
+}  // namespace scalar
+
+#ifdef H_SIMD_X86
+/// the vector kernels are written once (`search.inc`) over a 16 or 32 byte register and included
+/// into each instruction set's namespace; `Lanes` wraps the handful of intrinsics that differ.
+/// every function carries its own target attribute, so nothing is inlined across targets.
+namespace sse2 {
+    struct Lanes {
+        using reg = __m128i;
+
+        static constexpr usize width = 16;
+
+        H_TARGET("sse2") static reg splat(char chr) { return _mm_set1_epi8(chr); }
+        H_TARGET("sse2") static reg load(const char *ptr) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        }
+        H_TARGET("sse2") static reg eq(reg lhs, reg rhs) { return _mm_cmpeq_epi8(lhs, rhs); }
+        H_TARGET("sse2") static reg both(reg lhs, reg rhs) { return _mm_and_si128(lhs, rhs); }
+        H_TARGET("sse2") static reg either(reg lhs, reg rhs) { return _mm_or_si128(lhs, rhs); }
+        H_TARGET("sse2") static u32 mask(reg value) {
+            return static_cast<u32>(_mm_movemask_epi8(value));
+        }
+        H_TARGET("sse2") static reg zero() { return _mm_setzero_si128(); }
+        H_TARGET("sse2") static reg sub(reg lhs, reg rhs) { return _mm_sub_epi8(lhs, rhs); }
+        H_TARGET("sse2") static usize sum(reg counts) {
+            const __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+            return static_cast<usize>(_mm_cvtsi128_si64(sums)) +
+                   static_cast<usize>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+        }
+    };
+}  // namespace sse2
+
+namespace avx2 {
+    struct Lanes {
+        using reg = __m256i;
+
+        static constexpr usize width = 32;
+
+        H_TARGET("avx2") static reg splat(char chr) { return _mm256_set1_epi8(chr); }
+        H_TARGET("avx2") static reg load(const char *ptr) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        }
+        H_TARGET("avx2") static reg eq(reg lhs, reg rhs) { return _mm256_cmpeq_epi8(lhs, rhs); }
+        H_TARGET("avx2") static reg both(reg lhs, reg rhs) { return _mm256_and_si256(lhs, rhs); }
+        H_TARGET("avx2") static reg either(reg lhs, reg rhs) { return _mm256_or_si256(lhs, rhs); }
+        H_TARGET("avx2") static u32 mask(reg value) {
+            return static_cast<u32>(_mm256_movemask_epi8(value));
+        }
+        H_TARGET("avx2") static reg zero() { return _mm256_setzero_si256(); }
+        H_TARGET("avx2") static reg sub(reg lhs, reg rhs) { return _mm256_sub_epi8(lhs, rhs); }
+        H_TARGET("avx2") static usize sum(reg counts) {
+            const __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+            return static_cast<usize>(_mm256_extract_epi64(sums, 0)) + static_cast<usize>(_mm256_extract_epi64(sums, 1)) +
+                   static_cast<usize>(_mm256_extract_epi64(sums, 2)) + static_cast<usize>(_mm256_extract_epi64(sums, 3));
+        }
+    };
+}  // namespace avx2
+
+namespace sse2 {
+#define H_KERNEL_TARGET H_TARGET("sse2")
+#include "search.inc"
+#undef H_KERNEL_TARGET
+}  // namespace sse2
+
+namespace avx2 {
+#define H_KERNEL_TARGET H_TARGET("avx2")
+#include "search.inc"
+#undef H_KERNEL_TARGET
+}  // namespace avx2
+#endif
+
+inline Kernels detect() noexcept {
+#ifdef H_SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return {avx2::find_byte, avx2::count_byte, avx2::find, avx2::match_any};
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return {sse2::find_byte, sse2::count_byte, sse2::find, sse2::match_any};
+    }
+#endif
+    return {scalar::find_byte, scalar::count_byte, scalar::find, scalar::match_any};
+}
+
+inline const Kernels &kernels() noexcept {
+    static const Kernels table = detect();
+    return table;
+}
+
+/// \brief number of non-overlapping occurrences of `needle`, an empty needle never matches.
+inline usize count(const char *first, const char *last, const char *needle, usize size) {
+    if (size == 1) {
+        return kernels().count_byte(first, last, needle[0]);
+    }
+
+    usize count = 0;
+
+    if (size != 0) {
+        const auto find = kernels().find;
+
+        while ((first = find(first, last, needle, size)) != last) {
+            ++count;
+            first += size;
+        }
+    }
+
+    return count;
+}
+}  // namespace String::_search
+
+H_NAMESPACE_END
+
+#endif
@@ -0,0 +1,781 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_SEGMENT__
+#define __$LIBHELIX_STRING_SEGMENT__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../string.hh"
+#include "builder.hh"
+#include "unicode.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+namespace _segment {
+    /// the grapheme cluster break classes of UAX #29, the low four bits of a table entry.
+    enum Break : u8 { Other, CR, LF, Control, Extend, ZWJ, RI, Prepend, SpacingMark, L, V, T, LV, LVT };
+
+    inline constexpr u8 kind_mask = 0x0F;
+    inline constexpr u8 pict      = 1 << 4;  // Extended_Pictographic
+
+    /// the display width in columns, the top bits of a table entry.
+    inline constexpr u8 width_shift = 5;
+    inline constexpr u8 zero        = 0 << width_shift;
+    inline constexpr u8 narrow      = 1 << width_shift;
+    inline constexpr u8 wide        = 2 << width_shift;
+
+    struct Run {
+        u32 first;
+        u32 last;
+        u8  value;
+    };
+
+#include "segment_data.inc"
+
+    /// \struct Table
+    ///
+    /// Code point to entry, in two stages as in `casing.hh`: `stage1` picks one of the distinct
+    /// blocks of 128 code points, `stage2` holds the entry of each code point of that block, eight
+    /// to a word (entry `i` in byte `i % 8`, from the low end). Identical blocks are stored once,
+    /// about 24 KiB for the planes below `limit`.
+    template <usize Blocks>
+    struct Table {
+        static constexpr usize block_bits = 7;
+        static constexpr usize block_size = usize(1) << block_bits;
+        static constexpr usize words      = block_size / 8;
+
+        u8  stage1[limit >> block_bits];
+        u64 stage2[Blocks][words];
+    };
+
+    inline constexpr usize block_bits = Table<1>::block_bits;
+    inline constexpr usize block_size = Table<1>::block_size;
+    inline constexpr usize words      = Table<1>::words;
+
+    inline constexpr usize max_blocks = 192;  // distinct blocks, 171 for Unicode 14.0
+
+    /// `entry` in all eight bytes of a word.
+    constexpr u64 spread(u8 entry) noexcept { return entry * 0x0101010101010101ULL; }
+
+    /// \brief the table with room for `max_blocks`, filled in one pass over the blocks; `table`
+    /// below is a copy cut to the blocks actually used.
+    ///
+    /// each block is filled from the runs that overlap it and stored unless an identical one is
+    /// already there. blocks holding a single entry (most of them: unassigned, CJK, private use)
+    /// are recognized from the runs alone and matched by that entry, the others by a checksum
+    /// before they are compared in full. working a word at a time keeps this cheap enough to
+    /// evaluate in every translation unit.
+    struct Draft {
+        Table<max_blocks> table;
+        usize             count;
+    };
+
+    consteval Draft build_draft() {
+        constexpr usize run_count = sizeof(runs) / sizeof(Run);
+
+        Draft draft{};
+        u64   sums[max_blocks] = {};
+        usize uniform[256]     = {};  // index + 1 of the block filled with one entry
+        usize next             = 0;
+
+        for (usize block = 0; block < (limit >> block_bits); ++block) {
+            const u32 begin = static_cast<u32>(block << block_bits);
+            const u32 end   = begin + static_cast<u32>(block_size);
+
+            while (next < run_count && runs[next].last < begin) {
+                ++next;  // sorted and not overlapping
+            }
+
+            // a block between runs or inside one is known without filling it
+            const bool gap     = next == run_count || runs[next].first >= end;
+            const bool covered = !gap && runs[next].first <= begin && runs[next].last >= end - 1;
+            const u8   value   = gap ? static_cast<u8>(Other | narrow) : runs[next].value;
+
+            if ((gap || covered) && uniform[value] != 0) {
+                draft.table.stage1[block] = static_cast<u8>(uniform[value] - 1);
+                continue;
+            }
+
+            u64 entries[words] = {};
+            for (usize i = 0; i < words; ++i) {
+                entries[i] = spread(Other | narrow);
+            }
+
+            for (usize i = next; i < run_count && runs[i].first < end; ++i) {
+                const u32 first = runs[i].first < begin ? begin : runs[i].first;
+                const u32 last  = runs[i].last < end ? runs[i].last : end - 1;
+
+                for (u32 point = first; point <= last;) {
+                    const u32 at = point - begin;
+
+                    if ((at & 7) == 0 && last - point >= 7) {
+                        entries[at >> 3] = spread(runs[i].value);
+                        point += 8;
+                    } else {
+                        const u32 shift  = (at & 7) * 8;
+                        entries[at >> 3] = (entries[at >> 3] & ~(u64(0xFF) << shift)) | u64(runs[i].value) << shift;
+                        ++point;
+                    }
+                }
+            }
+
+            const u8 head   = static_cast<u8>(entries[0]);
+            bool     single = entries[0] == spread(head);
+            u64      sum    = 0;
+
+            for (usize i = 0; i < words; ++i) {
+                single = single && entries[i] == entries[0];
+                sum    = sum * 31 + entries[i];
+            }
+
+            usize found = 0;
+            for (; found < draft.count; ++found) {
+                bool same = sums[found] == sum;
+
+                for (usize i = 0; same && i < words; ++i) {
+                    same = draft.table.stage2[found][i] == entries[i];
+                }
+
+                if (same) {
+                    break;
+                }
+            }
+
+            if (found == draft.count) {
+                for (usize i = 0; i < words; ++i) {
+                    draft.table.stage2[found][i] = entries[i];
+                }
+
+                sums[draft.count++] = sum;
+
+                if (single) {
+                    uniform[head] = found + 1;
+                }
+            }
+
+            draft.table.stage1[block] = static_cast<u8>(found);
+        }
+
+        return draft;
+    }
+
+    inline constexpr Draft draft       = build_draft();
+    inline constexpr usize block_count = draft.count;
+
+    consteval Table<block_count> build_table() {
+        Table<block_count> table{};
+
+        for (usize block = 0; block < (limit >> block_bits); ++block) {
+            table.stage1[block] = draft.table.stage1[block];
+        }
+
+        for (usize index = 0; index < block_count; ++index) {
+            for (usize i = 0; i < words; ++i) {
+                table.stage2[index][i] = draft.table.stage2[index][i];
+            }
+        }
+
+        return table;
+    }
+
+    inline constexpr Table<block_count> table = build_table();
+
+    static_assert(block_count <= 256, "stage1 holds block indices in a byte");
+
+    constexpr u8 lookup(char32_t point) noexcept {
+        if (point < limit) {
+            const u64 word = table.stage2[table.stage1[point >> block_bits]][(point & (block_size - 1)) >> 3];
+            return static_cast<u8>(word >> ((point & 7) * 8));
+        }
+
+        // the tag block: tags and variation selectors extend, the rest is invisible control
+        if (point - 0xE0000 < 0x1000) {
+            return (point - 0xE0020 < 0x60) || (point - 0xE0100 < 0xF0) ? Extend | zero : Control | zero;
+        }
+
+        return Other | narrow;
+    }
+
+    /// \brief whether GB3 to GB9b allow a break between a code point of class `prev` and one of
+    /// class `next`; GB11 to GB13 also depend on what came before (see `breaks`).
+    constexpr bool pair_breaks(u8 prev, u8 next) noexcept {
+        if (prev == CR && next == LF) {
+            return false;
+        }
+
+        if (prev == CR || prev == LF || prev == Control || next == CR || next == LF || next == Control) {
+            return true;
+        }
+
+        if (prev == L && (next == L || next == V || next == LV || next == LVT)) {
+            return false;
+        }
+
+        if ((prev == LV || prev == V) && (next == V || next == T)) {
+            return false;
+        }
+
+        if ((prev == LVT || prev == T) && next == T) {
+            return false;
+        }
+
+        return next != Extend && next != ZWJ && next != SpacingMark && prev != Prepend;
+    }
+
+    /// bit `next` of `rows[prev]` is `pair_breaks(prev, next)`.
+    struct Pairs {
+        u16 rows[16];
+    };
+
+    consteval Pairs build_pairs() {
+        Pairs pairs{};
+
+        for (u8 prev = 0; prev <= LVT; ++prev) {
+            for (u8 next = 0; next <= LVT; ++next) {
+                pairs.rows[prev] |= static_cast<u16>(pair_breaks(prev, next) ? 1U << next : 0U);
+            }
+        }
+
+        return pairs;
+    }
+
+    inline constexpr Pairs pairs = build_pairs();
+
+    /// what GB11 to GB13 need to know about the code points before a position.
+    struct Context {
+        u8   emoji = 0;      // 1 after ExtPict Extend*, 2 after ExtPict Extend* ZWJ
+        bool odd   = false;  // an odd number of regional indicators in a row
+
+        constexpr void push(u8 entry) noexcept {
+            const u8 kind = entry & kind_mask;
+
+            emoji = (entry & pict) != 0                ? 1
+                    : emoji == 1 && kind == Extend     ? 1
+                    : emoji == 1 && kind == ZWJ        ? 2
+                                                       : 0;
+            odd   = kind == RI && !odd;
+        }
+    };
+
+    constexpr bool breaks(u8 prev, u8 next, const Context &context) noexcept {
+        const u8 before = prev & kind_mask;
+        const u8 after  = next & kind_mask;
+
+        if (((pairs.rows[before] >> after) & 1) == 0) {
+            return false;
+        }
+
+        if (before == ZWJ && context.emoji == 2 && (next & pict) != 0) {
+            return false;  // GB11, inside an emoji zwj sequence
+        }
+
+        return !(before == RI && after == RI && context.odd);  // GB12 and GB13, flags are pairs
+    }
+
+    constexpr usize columns_of(u8 entry) noexcept { return entry >> width_shift; }
+
+    /// a malformed byte is a cluster of its own, one column wide (it is shown as U+FFFD).
+    inline constexpr u8 malformed = Control | narrow;
+
+    struct Point {
+        u8       entry;
+        usize    length;
+        char32_t point;
+    };
+
+    constexpr Point decode(const char *src, const char *last) noexcept {
+        const auto lead = static_cast<unsigned char>(*src);
+
+        if (lead < 0x80) {
+            return {lookup(lead), 1, lead};
+        }
+
+        const _unicode::Step step = _unicode::read(src, last);
+
+        if (step.error != Unicode::Error::None) {
+            return {malformed, 1, 0xFFFD};
+        }
+
+        return {lookup(step.point), step.length, step.point};
+    }
+
+    /// \brief the end of the cluster starting at `src`, whose first code point is already decoded
+    /// in `current`; its width in columns goes to `columns`.
+    ///
+    /// `current` is left holding the code point at the returned end (when it is not `last`), so
+    /// a walk over many clusters decodes each code point once. a cluster is as wide as its widest
+    /// code point, except that a pictograph followed by U+FE0F (emoji presentation) and a flag
+    /// (two regional indicators) take two columns.
+    constexpr const char *cluster(const char *src, const char *last, Point &current, usize &columns) noexcept {
+        Context context;
+        context.push(current.entry);
+
+        const u8 first = current.entry;
+        usize    width = columns_of(first);
+
+        for (src += current.length; src != last; src += current.length) {
+            const Point next = decode(src, last);
+            const u8    prev = current.entry;
+
+            current = next;
+
+            if (breaks(prev, next.entry, context)) {
+                break;
+            }
+
+            width = width < columns_of(next.entry) ? columns_of(next.entry) : width;
+
+            if ((next.point == 0xFE0F && (first & pict) != 0) || (next.entry & kind_mask) == RI) {
+                width = 2;
+            }
+
+            context.push(next.entry);
+        }
+
+        columns = width;
+        return src;
+    }
+
+    constexpr const char *cluster(const char *src, const char *last, usize &columns) noexcept {
+        Point current = decode(src, last);
+        return cluster(src, last, current, columns);
+    }
+
+    /// whether `pos` is a continuation byte of a well formed sequence that starts before it.
+    constexpr bool inside(const char *first, const char *pos, const char *last) noexcept {
+        const char *lead = pos;
+
+        for (usize i = 0; i < 3 && lead != first && (static_cast<unsigned char>(*lead) & 0xC0) == 0x80; ++i) {
+            --lead;
+        }
+
+        if (lead == pos || (static_cast<unsigned char>(*lead) & 0xC0) == 0x80) {
+            return false;
+        }
+
+        const _unicode::Step step = _unicode::read(lead, last);
+        return step.error == Unicode::Error::None && lead + step.length > pos;
+    }
+
+    /// the start of the code point (or malformed byte) that ends at `pos`.
+    constexpr const char *back(const char *first, const char *pos, const char *last) noexcept {
+        const char *lead = pos - 1;
+
+        for (usize i = 0; i < 3 && lead != first && (static_cast<unsigned char>(*lead) & 0xC0) == 0x80; ++i) {
+            --lead;
+        }
+
+        const _unicode::Step step = _unicode::read(lead, last);
+        return step.error == Unicode::Error::None && lead + step.length == pos ? lead : pos - 1;
+    }
+
+    /// \brief whether a cluster boundary lies at `pos`, from the code points around it.
+    ///
+    /// the rules are pairwise except GB11 and GB13, for those the code points before `pos` are
+    /// walked back only as far as the rule needs.
+    constexpr bool is_boundary(const char *first, const char *pos, const char *last) noexcept {
+        if (pos == first || pos == last) {
+            return true;
+        }
+
+        if (inside(first, pos, last)) {
+            return false;
+        }
+
+        const char *before = back(first, pos, last);
+        const u8    prev   = decode(before, last).entry;
+        const u8    next   = decode(pos, last).entry;
+
+        Context context;
+
+        if ((prev & kind_mask) == ZWJ && (next & pict) != 0) {
+            for (const char *at = before; at != first;) {
+                at = back(first, at, last);
+
+                const u8 entry = decode(at, last).entry;
+
+                if ((entry & pict) != 0) {
+                    context.emoji = 2;
+                }
+
+                if ((entry & kind_mask) != Extend) {
+                    break;
+                }
+            }
+        }
+
+        if ((prev & kind_mask) == RI && (next & kind_mask) == RI) {
+            for (const char *at = pos; at != first;) {
+                at = back(first, at, last);
+
+                if ((decode(at, last).entry & kind_mask) != RI) {
+                    break;
+                }
+
+                context.odd = !context.odd;
+            }
+        }
+
+        return breaks(prev, next, context);
+    }
+
+    constexpr const char *floor(const char *first, const char *pos, const char *last) noexcept {
+        while (!is_boundary(first, pos, last)) {
+            pos = inside(first, pos, last) ? pos - 1 : back(first, pos, last);
+        }
+
+        return pos;
+    }
+
+    constexpr const char *ceil(const char *first, const char *pos, const char *last) noexcept {
+        while (!is_boundary(first, pos, last)) {
+            pos += inside(first, pos, last) ? 1 : decode(pos, last).length;
+        }
+
+        return pos;
+    }
+
+    struct Measure {
+        usize clusters = 0;
+        usize columns  = 0;
+    };
+
+    namespace scalar {
+        /// see `segment.inc`, one byte at a time.
+        inline usize ascii_measure(const char *src, usize count, Measure &total) noexcept {
+            usize done = 0;
+
+            while (done < count) {
+                const auto chr     = static_cast<unsigned char>(src[done]);
+                const bool control = chr < 0x20 || chr == 0x7F;
+
+                if (chr >= 0x80) {
+                    break;
+                }
+
+                if (done + 1 < count) {
+                    const auto after = static_cast<unsigned char>(src[done + 1]);
+
+                    if (chr == '\r' && after == '\n') {
+                        ++total.clusters;
+                        done += 2;
+                        continue;
+                    }
+
+                    if (after >= 0x80 && !control) {
+                        break;  // may start a longer cluster, a control never does
+                    }
+                }
+
+                ++total.clusters;
+                total.columns += control ? 0 : 1;
+                ++done;
+            }
+
+            return done;
+        }
+    }  // namespace scalar
+
+#ifdef H_SIMD_X86
+    namespace ssse3 {
+        using Lanes = _unicode::ssse3::Lanes;
+
+#define H_KERNEL_TARGET H_TARGET("ssse3")
+#include "segment.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace ssse3
+
+    namespace avx2 {
+        using Lanes = _unicode::avx2::Lanes;
+
+#define H_KERNEL_TARGET H_TARGET("avx2")
+#include "segment.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace avx2
+#endif
+
+    inline usize ascii_measure(const char *src, usize count, Measure &total) noexcept {
+#ifdef H_SIMD_X86
+        switch (_unicode::level()) {
+            case _unicode::Level::AVX2:
+                return avx2::ascii_measure(src, count, total);
+            case _unicode::Level::SSSE3:
+                return ssse3::ascii_measure(src, count, total);
+            default:
+                break;
+        }
+#endif
+        return scalar::ascii_measure(src, count, total);
+    }
+
+    /// clusters and columns of `[first, last)`: ASCII runs through the kernels, the rest one
+    /// cluster at a time through the table.
+    inline Measure measure(const char *first, const char *last) noexcept {
+        Measure total;
+
+        while (first != last) {
+            first += ascii_measure(first, static_cast<usize>(last - first), total);
+
+            if (first == last) {
+                break;
+            }
+
+            // clusters one after another until the next one starts with ASCII again
+            Point point = decode(first, last);
+
+            do {
+                usize columns = 0;
+                first         = cluster(first, last, point, columns);
+
+                ++total.clusters;
+                total.columns += columns;
+            } while (first != last && point.point >= 0x80);
+        }
+
+        return total;
+    }
+
+    /// the end of the longest run of whole clusters from `first` that fits in `columns`.
+    inline const char *fit(const char *first, const char *last, usize columns) noexcept {
+        while (first != last) {
+            usize       width = 0;
+            const char *end   = cluster(first, last, width);
+
+            if (width > columns) {
+                break;
+            }
+
+            columns -= width;
+            first = end;
+        }
+
+        return first;
+    }
+
+    template <typename Text>
+    concept Utf8 = _unicode::Encoded<Text> && sizeof(_unicode::unit_of<Text>) == 1;
+
+    template <typename Text>
+    const char *begin_of(const Text &text) noexcept {
+        return reinterpret_cast<const char *>(text.data());
+    }
+
+    template <typename Text>
+    const char *end_of(const Text &text) noexcept {
+        return reinterpret_cast<const char *>(text.data()) + text.size();
+    }
+
+    /// \class Clusters
+    ///
+    /// The clusters of a UTF-8 text as slices, found one at a time as the range is walked.
+    class Clusters {
+      public:
+        class iterator {
+          public:
+            using value_type        = slice<char>;
+            using difference_type   = isize;
+            using iterator_category = LIBCXX_NAMESPACE::forward_iterator_tag;
+
+            iterator() noexcept = default;
+            iterator(const char *pos, const char *last) noexcept
+                : m_pos(pos)
+                , m_end(pos)
+                , m_last(last) {
+                find();
+            }
+
+            slice<char> operator*() const noexcept { return {m_pos, static_cast<usize>(m_end - m_pos)}; }
+
+            iterator &operator++() noexcept {
+                m_pos = m_end;
+                find();
+                return *this;
+            }
+
+            iterator operator++(int) noexcept {
+                iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept { return lhs.m_pos == rhs.m_pos; }
+
+          private:
+            void find() noexcept {
+                usize columns = 0;
+                m_end         = m_pos != m_last ? cluster(m_pos, m_last, columns) : m_last;
+            }
+
+            const char *m_pos  = nullptr;
+            const char *m_end  = nullptr;
+            const char *m_last = nullptr;
+        };
+
+        Clusters(const char *first, const char *last) noexcept
+            : m_first(first)
+            , m_last(last) {}
+
+        [[nodiscard]] iterator begin() const noexcept { return {m_first, m_last}; }
+        [[nodiscard]] iterator end() const noexcept { return {m_last, m_last}; }
+
+      private:
+        const char *m_first;
+        const char *m_last;
+    };
+
+    /// `fill` copies and spaces for `columns` of padding: only whole copies of `fill`, which may
+    /// be several columns or bytes wide, and a space for each column they leave over.
+    struct Padding {
+        usize copies;
+        usize spaces;
+    };
+
+    constexpr Padding pad(usize columns, usize fill_columns) noexcept {
+        return {columns / fill_columns, columns % fill_columns};
+    }
+
+    /// the display width counterpart of `_builder::align`. the leftover spaces go next to the
+    /// text, so the fill pattern reaches the edges.
+    template <usize _SlabSize>
+    basic<char, _SlabSize> align(slice<char> text, usize columns, slice<char> fill, usize left_share) {
+        const usize measured     = measure(text.data(), text.data() + text.size()).columns;
+        const usize fill_columns = measure(fill.data(), fill.data() + fill.size()).columns;
+
+        if (measured >= columns || fill_columns == 0) {
+            return {text.data(), text.size()};
+        }
+
+        const usize   padding = columns - measured;
+        const Padding left    = pad(padding * left_share / 2, fill_columns);
+        const Padding right   = pad(padding - padding * left_share / 2, fill_columns);
+
+        builder<char> out(text.size() + (left.copies + right.copies) * fill.size() + left.spaces + right.spaces);
+        out.repeat(fill, left.copies * fill.size()).repeat(' ', left.spaces);
+        out.append(text);
+        out.repeat(' ', right.spaces).repeat(fill, right.copies * fill.size());
+
+        return out.template build<_SlabSize>();
+    }
+}  // namespace _segment
+
+namespace Unicode {
+    /// \include belongs to the helix standard library.
+    /// \brief the columns `point` takes in a terminal: 0 for combining marks, controls and
+    /// format characters, 2 for East Asian Wide and Fullwidth characters, 1 otherwise.
+    constexpr usize width(char32_t point) noexcept { return _segment::columns_of(_segment::lookup(point)); }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the number of user perceived characters (extended grapheme clusters, UAX #29) in
+    /// UTF-8 `text`.
+    ///
+    /// runs of ASCII are counted a vector register at a time, everything else one cluster at a
+    /// time through two stage tables built at compile time. each malformed byte counts as one.
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    usize grapheme_count(const Text &text) noexcept {
+        return _segment::measure(_segment::begin_of(text), _segment::end_of(text)).clusters;
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the columns UTF-8 `text` takes in a terminal, the sum of its clusters' widths.
+    ///
+    /// ```cpp
+    /// String::Unicode::width(String::slice<char>("漢字 ok"));  // 7
+    /// ```
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    usize width(const Text &text) noexcept {
+        return _segment::measure(_segment::begin_of(text), _segment::end_of(text)).columns;
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the clusters of UTF-8 `text`, each as a `slice<char>`, found lazily.
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    _segment::Clusters graphemes(const Text &text) noexcept {
+        return {_segment::begin_of(text), _segment::end_of(text)};
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief whether splitting UTF-8 `text` at byte offset `pos` keeps every cluster whole.
+    ///
+    /// decided from the code points around `pos`, so it costs the same anywhere in the text.
+    /// `floor_grapheme` and `ceil_grapheme` move an offset to the nearest boundary at or before,
+    /// and at or after it.
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    bool is_grapheme_boundary(const Text &text, usize pos) noexcept {
+        const char *first = _segment::begin_of(text);
+        return pos <= text.size() && _segment::is_boundary(first, first + pos, _segment::end_of(text));
+    }
+
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    usize floor_grapheme(const Text &text, usize pos) noexcept {
+        const char *first = _segment::begin_of(text);
+        pos               = pos < text.size() ? pos : text.size();
+
+        return static_cast<usize>(_segment::floor(first, first + pos, _segment::end_of(text)) - first);
+    }
+
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    usize ceil_grapheme(const Text &text, usize pos) noexcept {
+        const char *first = _segment::begin_of(text);
+        pos               = pos < text.size() ? pos : text.size();
+
+        return static_cast<usize>(_segment::ceil(first, first + pos, _segment::end_of(text)) - first);
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the longest prefix of whole clusters of UTF-8 `text` that fits in `columns`.
+    template <typename Text>
+        requires _segment::Utf8<Text>
+    slice<char> truncate(const Text &text, usize columns) noexcept {
+        const char *first = _segment::begin_of(text);
+        return {first, static_cast<usize>(_segment::fit(first, _segment::end_of(text), columns) - first)};
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief UTF-8 `text` padded to `columns` display columns with whole copies of `fill`,
+    /// spaces making up any columns a copy would overrun; text that is already as wide (or a
+    /// fill with no width) is returned unchanged.
+    ///
+    /// the display width counterparts of `String::left_align` and friends, for text that is
+    /// not all ASCII.
+    template <usize _SlabSize = 16>
+    basic<char, _SlabSize> left_align(slice<char> text, usize columns, slice<char> fill = {_builder::space<char>, 1}) {
+        return _segment::align<_SlabSize>(text, columns, fill, 0);
+    }
+
+    template <usize _SlabSize = 16>
+    basic<char, _SlabSize> right_align(slice<char> text, usize columns, slice<char> fill = {_builder::space<char>, 1}) {
+        return _segment::align<_SlabSize>(text, columns, fill, 2);
+    }
+
+    /// the odd column of padding goes to the right.
+    template <usize _SlabSize = 16>
+    basic<char, _SlabSize> center_align(slice<char> text, usize columns, slice<char> fill = {_builder::space<char>, 1}) {
+        return _segment::align<_SlabSize>(text, columns, fill, 1);
+    }
+}  // namespace Unicode
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
@@ -0,0 +1,352 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_SHARED__
+#define __$LIBHELIX_STRING_SHARED__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../../print/buffer.h"
+#include "../errors.h"
+#include "../string.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+/// how the reference count of a `shared` string is kept: `Atomic` for strings whose copies may
+/// be used from several threads, `Local` (plain increments) for strings that stay on one.
+enum class Sharing : u8 { Local, Atomic };
+
+namespace _shared {
+    template <Sharing>
+    struct Count;
+
+    template <>
+    struct Count<Sharing::Local> {
+        usize value = 1;
+
+        void               acquire() noexcept { ++value; }
+        bool               release() noexcept { return --value == 0; }
+        [[nodiscard]] usize load() const noexcept { return value; }
+    };
+
+    /// relaxed increments; the decrement that frees the buffer synchronizes with every earlier
+    /// one, so writes made through other copies happen before the free.
+    template <>
+    struct Count<Sharing::Atomic> {
+        LIBCXX_NAMESPACE::atomic<usize> value{1};
+
+        void acquire() noexcept { value.fetch_add(1, LIBCXX_NAMESPACE::memory_order_relaxed); }
+        bool release() noexcept { return value.fetch_sub(1, LIBCXX_NAMESPACE::memory_order_acq_rel) == 1; }
+        [[nodiscard]] usize load() const noexcept { return value.load(LIBCXX_NAMESPACE::memory_order_acquire); }
+    };
+
+    /// the count and capacity, followed by the characters in the same allocation.
+    template <typename CharT, Sharing S>
+    struct Block {
+        Count<S> refs;
+        usize    capacity;
+
+        CharT *chars() noexcept { return reinterpret_cast<CharT *>(this + 1); }
+
+        static Block *make(usize capacity) {
+            static_assert(alignof(Block) >= alignof(CharT));
+
+            void *memory = ::operator new(sizeof(Block) + capacity * sizeof(CharT));
+            return ::new (memory) Block{{}, capacity};
+        }
+
+        static void destroy(Block *block) noexcept {
+            block->~Block();
+            ::operator delete(block);
+        }
+    };
+
+    template <typename CharT>
+    inline constexpr CharT empty[1] = {};
+}  // namespace _shared
+
+/// \class shared
+///
+/// An immutable string whose copies share one buffer. Copying and taking substrings are O(1)
+/// and never touch the characters, so strings can be passed by value through any number of
+/// stages; only an explicit mutation copies, and only when the buffer is not owned alone.
+///
+/// ### Design Details
+/// - **Buffer**: one allocation holds a reference count, the capacity and the characters. A
+///   string is a pointer to it plus the `[data, data + size)` window it views, so a substring
+///   is the same buffer with a narrower window.
+/// - **Literals**: a `String::literal` (`"text"_s`) is referenced where the compiler placed it,
+///   with no buffer and no count, like the ROM storage of `basic`. Arrays are copied.
+/// - **Copy on write**: `append`, `push_back` and `mutable_data()` first make the string the sole
+///   owner of a buffer holding its window (copying it when the buffer is shared, a literal, or too
+///   small), then write in place. Appends to a sole owner grow the buffer geometrically.
+/// - **Threads**: with `Sharing::Atomic` (the default) copies may be handed to other threads; the
+///   count is then atomic. `Sharing::Local` uses plain increments, for strings whose copies never
+///   leave the thread that made them.
+///
+/// ### Notes
+/// - Substrings keep the whole parent buffer alive. copy into a new `shared` (construct from the
+///   slice) to let a large parent go.
+/// - The characters are not null terminated, a substring ends inside its parent.
+///
+/// \tparam CharT The element type of the string
+/// \tparam _Sharing How the reference count is kept
+template <typename CharT, Sharing _Sharing = Sharing::Atomic>
+class shared {
+    static_assert(LIBCXX_NAMESPACE::is_trivially_copyable_v<CharT>, "String::shared copies characters with memcpy");
+
+    using Block = _shared::Block<CharT, _Sharing>;
+
+  public:
+    using value_type      = CharT;
+    using size_type       = usize;
+    using difference_type = isize;
+    using const_reference = const CharT &;
+    using const_pointer   = const CharT *;
+    using const_iterator  = const CharT *;
+    using iterator        = const CharT *;
+
+    static constexpr size_type npos = slice<CharT>::npos;
+
+    shared() noexcept = default;
+
+    /// references the literal in place, see the class notes.
+    shared(literal<CharT> text) noexcept  // NOLINT(google-explicit-constructor)
+        : m_data(text.data())
+        , m_size(text.size()) {}
+
+    /// an array is copied up to its first null character, only literals are referenced.
+    template <usize N>
+    shared(const CharT (&array)[N]) {  // NOLINT(google-explicit-constructor)
+        assign(array, _string::array_length(array));
+    }
+
+    template <usize N>
+    explicit shared(CharT (&buffer)[N]) {
+        assign(buffer, _string::array_length(buffer));
+    }
+
+    shared(const CharT *str, size_type size) { assign(str, size); }
+
+    explicit shared(slice<CharT> text)
+        : shared(text.data(), text.size()) {}
+
+    template <usize S, typename A>
+    explicit shared(const basic<CharT, S, A> &text)
+        : shared(text.data(), text.size()) {}
+
+    shared(const shared &other) noexcept
+        : m_block(other.m_block)
+        , m_data(other.m_data)
+        , m_size(other.m_size) {
+        if (m_block != nullptr) {
+            m_block->refs.acquire();
+        }
+    }
+
+    shared(shared &&other) noexcept
+        : m_block(other.m_block)
+        , m_data(other.m_data)
+        , m_size(other.m_size) {
+        other.reset();
+    }
+
+    shared &operator=(const shared &other) noexcept {
+        if (other.m_block != nullptr) {
+            other.m_block->refs.acquire();  // first, `other` may be the last owner of our buffer
+        }
+
+        release();
+
+        m_block = other.m_block;
+        m_data  = other.m_data;
+        m_size  = other.m_size;
+
+        return *this;
+    }
+
+    shared &operator=(shared &&other) noexcept {
+        if (this != &other) {
+            release();
+
+            m_block = other.m_block;
+            m_data  = other.m_data;
+            m_size  = other.m_size;
+
+            other.reset();
+        }
+
+        return *this;
+    }
+
+    ~shared() { release(); }
+
+    const_reference operator[](size_type pos) const noexcept { return m_data[pos]; }
+
+    const_reference at(size_type pos) const {
+        if (pos >= m_size) {
+            throw H_STD_NAMESPACE::errors::RuntimeError("shared string index out of range.");
+        }
+
+        return m_data[pos];
+    }
+
+    [[nodiscard]] const_pointer data() const noexcept { return m_data; }
+    [[nodiscard]] size_type     size() const noexcept { return m_size; }
+    [[nodiscard]] size_type     length() const noexcept { return m_size; }
+    [[nodiscard]] bool          empty() const noexcept { return m_size == 0; }
+
+    const_iterator begin() const noexcept { return m_data; }
+    const_iterator end() const noexcept { return m_data + m_size; }
+
+    /// number of strings sharing the buffer, 0 for literals and the empty string.
+    [[nodiscard]] size_type use_count() const noexcept { return m_block != nullptr ? m_block->refs.load() : 0; }
+
+    slice<CharT> as_slice() const noexcept { return {m_data, m_size}; }
+    operator slice<CharT>() const noexcept { return as_slice(); }  // NOLINT(google-explicit-constructor)
+
+    /// the `count` characters starting at `pos`, clamped to the end; shares this buffer.
+    shared substr(size_type pos, size_type count = npos) const {
+        if (pos > m_size) {
+            throw H_STD_NAMESPACE::errors::RuntimeError("shared string substr position out of range.");
+        }
+
+        const size_type left = m_size - pos;
+
+        shared result(*this);
+        result.m_data += pos;
+        result.m_size  = count < left ? count : left;
+
+        return result;
+    }
+
+    size_type find(CharT chr, size_type from = 0) const noexcept { return as_slice().find(chr, from); }
+    size_type find(slice<CharT> needle, size_type from = 0) const noexcept { return as_slice().find(needle, from); }
+    size_type count(CharT chr) const noexcept { return as_slice().count(chr); }
+    size_type count(slice<CharT> needle) const noexcept { return as_slice().count(needle); }
+    bool      contains(CharT chr) const noexcept { return find(chr) != npos; }
+    bool      contains(slice<CharT> needle) const noexcept { return find(needle) != npos; }
+    bool      starts_with(slice<CharT> prefix) const noexcept { return as_slice().starts_with(prefix); }
+    bool      ends_with(slice<CharT> suffix) const noexcept { return as_slice().ends_with(suffix); }
+    int       compare(slice<CharT> other) const noexcept { return as_slice().compare(other); }
+
+    /// \brief writable characters, copied first unless this string owns its buffer alone.
+    CharT *mutable_data() {
+        make_unique(m_size);
+        return const_cast<CharT *>(m_data);
+    }
+
+    shared &append(slice<CharT> text) {
+        const size_type size = m_size + text.size();
+
+        if (text.empty()) {
+            return *this;
+        }
+
+        if (!owns(size)) {
+            replace(text, grown(size));
+            return *this;
+        }
+
+        // the sole owner with room, `text` may still view this buffer
+        LIBCXX_NAMESPACE::memmove(const_cast<CharT *>(m_data) + m_size, text.data(), text.size() * sizeof(CharT));
+        m_size = size;
+
+        return *this;
+    }
+
+    shared &push_back(CharT chr) { return append(slice<CharT>(&chr, 1)); }
+
+    shared &operator+=(slice<CharT> text) { return append(text); }
+    shared &operator+=(CharT chr) { return push_back(chr); }
+
+    friend bool operator==(const shared &lhs, const shared &rhs) noexcept { return lhs.as_slice() == rhs.as_slice(); }
+    friend bool operator!=(const shared &lhs, const shared &rhs) noexcept { return !(lhs == rhs); }
+    friend bool operator<(const shared &lhs, const shared &rhs) noexcept { return lhs.compare(rhs) < 0; }
+    friend bool operator<=(const shared &lhs, const shared &rhs) noexcept { return lhs.compare(rhs) <= 0; }
+    friend bool operator>(const shared &lhs, const shared &rhs) noexcept { return lhs.compare(rhs) > 0; }
+    friend bool operator>=(const shared &lhs, const shared &rhs) noexcept { return lhs.compare(rhs) >= 0; }
+
+    void operator$format(H_STD_NAMESPACE::Format::Buffer &out) const
+        requires(std::Meta::same_as<CharT, char>)
+    {
+        out.append(m_data, m_size);
+    }
+
+  private:
+    /// whether this string owns its buffer alone with room for `size` characters from `m_data`.
+    [[nodiscard]] bool owns(size_type size) const noexcept {
+        return m_block != nullptr && m_block->refs.load() == 1 && m_data + size <= m_block->chars() + m_block->capacity;
+    }
+
+    [[nodiscard]] size_type grown(size_type required) const noexcept {
+        const size_type doubled = m_size * 2;
+        return doubled < required ? required : doubled;
+    }
+
+    void make_unique(size_type size) {
+        if (!owns(size)) {
+            replace({}, size);
+        }
+    }
+
+    /// move to a fresh buffer of `capacity` holding the current window then `extra`. the old
+    /// buffer is released last, `extra` may view it.
+    void replace(slice<CharT> extra, size_type capacity) {
+        Block *block = Block::make(capacity);
+        CharT *chars = block->chars();
+
+        LIBCXX_NAMESPACE::memcpy(chars, m_data, m_size * sizeof(CharT));
+        if (!extra.empty()) {
+            LIBCXX_NAMESPACE::memcpy(chars + m_size, extra.data(), extra.size() * sizeof(CharT));
+        }
+
+        const size_type size = m_size + extra.size();
+        release();
+
+        m_block = block;
+        m_data  = chars;
+        m_size  = size;
+    }
+
+    void assign(const CharT *str, size_type size) {
+        if (size != 0) {
+            replace({str, size}, size);  // the empty string needs no buffer
+        }
+    }
+
+    void release() noexcept {
+        if (m_block != nullptr && m_block->refs.release()) {
+            Block::destroy(m_block);
+        }
+    }
+
+    void reset() noexcept {
+        m_block = nullptr;
+        m_data  = _shared::empty<CharT>;
+        m_size  = 0;
+    }
+
+    Block        *m_block = nullptr;
+    const CharT  *m_data  = _shared::empty<CharT>;
+    size_type     m_size  = 0;
+};
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
@@ -0,0 +1,305 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_SPLIT__
+#define __$LIBHELIX_STRING_SPLIT__
+
+#include "../../config.h"
+#include "../../lang/generator.hh"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../errors.h"
+#include "../string.hh"
+#include "search.hh"
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+namespace _split {
+    template <typename Text>
+    using char_of = LIBCXX_NAMESPACE::remove_cvref_t<decltype(*LIBCXX_NAMESPACE::declval<const Text &>().data())>;
+
+    /// anything with contiguous `data()`/`size()` that outlives the splitter: an lvalue string,
+    /// or a view (a temporary `basic` would leave every token dangling).
+    template <typename Text>
+    concept Source = requires(const Text &text) {
+        { text.data() };
+        { text.size() } -> LIBCXX_NAMESPACE::convertible_to<usize>;
+    } && (LIBCXX_NAMESPACE::is_lvalue_reference_v<Text> || LIBCXX_NAMESPACE::is_same_v<LIBCXX_NAMESPACE::remove_cvref_t<Text>, slice<char_of<Text>>>);
+
+    template <typename Text>
+    slice<char_of<Text>> view(const Text &text) noexcept {
+        return {text.data(), static_cast<usize>(text.size())};
+    }
+
+    /// \struct Scanner
+    ///
+    /// Finds the bytes of a small set 64 at a time: one `match_any` call turns a window into a bit
+    /// mask of delimiter positions, and every token inside that window is then a `countr_zero`.
+    /// Short tokens (CSV fields, words) no longer pay a kernel call each.
+    struct Scanner {
+        const char *m_window = nullptr;
+        u64         m_mask   = 0;
+
+        const char *find(const char *from, const char *last, const char *set, usize size) noexcept {
+            while (true) {
+                if (m_window != nullptr && from >= m_window && from < m_window + _search::window) {
+                    const u64 mask = m_mask & (~u64(0) << (from - m_window));
+
+                    if (mask != 0) {
+                        return m_window + LIBCXX_NAMESPACE::countr_zero(mask);
+                    }
+
+                    from = m_window + _search::window;
+                }
+
+                if (static_cast<usize>(last - from) < _search::window) {
+                    m_window = nullptr;
+                    return _search::scalar::find_any(from, last, set, size);
+                }
+
+                m_window = from;
+                m_mask   = _search::kernels().match_any(from, set, size);
+            }
+        }
+    };
+
+    template <typename CharT>
+    const CharT *find_any(Scanner &scanner, const CharT *from, const CharT *last, const CharT *set, usize size) noexcept {
+        if constexpr (_string::is_byte<CharT>) {
+            const auto *found = scanner.find(reinterpret_cast<const char *>(from), reinterpret_cast<const char *>(last),
+                                             reinterpret_cast<const char *>(set), size);
+            return reinterpret_cast<const CharT *>(found);
+        } else {
+            return LIBCXX_NAMESPACE::find_first_of(from, last, set, set + size);
+        }
+    }
+
+    /// \brief the delimiters: `find(from, last)` returns the next delimiter at or after `from`
+    /// (`last` when there is none) and `width()` how many characters it covers.
+    template <typename CharT>
+    struct Char {
+        CharT   chr;
+        Scanner scanner{};
+
+        const CharT *find(const CharT *from, const CharT *last) noexcept { return find_any(scanner, from, last, &chr, 1); }
+        [[nodiscard]] usize width() const noexcept { return 1; }
+    };
+
+    template <typename CharT>
+    struct AnyOf {
+        slice<CharT> set;
+        Scanner      scanner{};
+
+        const CharT *find(const CharT *from, const CharT *last) noexcept {
+            return find_any(scanner, from, last, set.data(), set.size());
+        }
+        [[nodiscard]] usize width() const noexcept { return 1; }
+    };
+
+    template <typename CharT>
+    struct Needle {
+        slice<CharT> needle;
+
+        const CharT *find(const CharT *from, const CharT *last) const noexcept {
+            const usize found = slice<CharT>(from, static_cast<usize>(last - from)).find(needle);
+            return found != slice<CharT>::npos ? from + found : last;
+        }
+        [[nodiscard]] usize width() const noexcept { return needle.size(); }
+    };
+
+    template <typename CharT, typename Pred>
+    struct Predicate {
+        Pred pred;
+
+        const CharT *find(const CharT *from, const CharT *last) { return LIBCXX_NAMESPACE::find_if(from, last, pred); }
+        [[nodiscard]] usize width() const noexcept { return 1; }
+    };
+}  // namespace _split
+
+/// \class splitter
+///
+/// A lazy split of a string into the pieces between its delimiters. Every piece is a `slice`
+/// into the original characters, so splitting never allocates and never copies; the text (and
+/// a multi character delimiter or delimiter set) must outlive the splitter and its pieces.
+///
+/// ### Design Details
+/// - **Semantics**: like `str.split(sep)` in Python, `n` delimiters give `n + 1` pieces,
+///   including empty ones at the ends and between adjacent delimiters. `skip_empty()` drops the
+///   empty pieces, which is how whitespace separated words are usually wanted.
+/// - **Scanning**: single characters and character sets on byte strings are found 64 bytes at a
+///   time with the `_search` vector kernels, the resulting bit mask serves every piece inside the
+///   window. multi character delimiters use the `slice::find` kernel, predicates a plain loop.
+/// - **Single pass**: the splitter is its own cursor. `begin()` starts where the last piece left
+///   off, so a splitter is iterated once; split again for a second pass (it is cheap, nothing is
+///   computed up front). `next(piece)` pulls pieces without iterators.
+///
+/// \tparam CharT The element type of the string
+/// \tparam Delimiter One of the `_split` delimiters
+template <typename CharT, typename Delimiter>
+class splitter {
+  public:
+    struct sentinel {};
+
+    class iterator {
+      public:
+        using iterator_concept = LIBCXX_NAMESPACE::input_iterator_tag;
+        using value_type       = slice<CharT>;
+        using difference_type  = isize;
+
+        iterator() noexcept = default;
+
+        const slice<CharT> &operator*() const noexcept { return m_piece; }
+        const slice<CharT> *operator->() const noexcept { return &m_piece; }
+
+        iterator &operator++() {
+            m_live = m_owner->next(m_piece);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator &it, sentinel) noexcept { return !it.m_live; }
+
+      private:
+        friend class splitter;
+
+        explicit iterator(splitter *owner)
+            : m_owner(owner) {
+            ++*this;
+        }
+
+        splitter    *m_owner = nullptr;
+        slice<CharT> m_piece;
+        bool         m_live = false;
+    };
+
+    splitter(slice<CharT> text, Delimiter delimiter) noexcept
+        : m_delimiter(LIBCXX_NAMESPACE::move(delimiter))
+        , m_pos(text.begin())
+        , m_last(text.end()) {}
+
+    iterator begin() { return iterator(this); }
+    sentinel end() const noexcept { return {}; }
+
+    /// the same split, without the empty pieces.
+    splitter skip_empty() const {
+        splitter copy = *this;
+        copy.m_skip   = true;
+        return copy;
+    }
+
+    /// \brief store the next piece in `piece`, false once every piece has been handed out.
+    bool next(slice<CharT> &piece) {
+        while (!m_done) {
+            const CharT *found = m_delimiter.find(m_pos, m_last);
+            piece              = slice<CharT>(m_pos, static_cast<usize>(found - m_pos));
+
+            if (found == m_last) {
+                m_done = true;
+            } else {
+                m_pos = found + m_delimiter.width();
+            }
+
+            if (!m_skip || !piece.empty()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// the text not split yet, empty once the last piece has been handed out.
+    [[nodiscard]] slice<CharT> remainder() const noexcept {
+        return m_done ? slice<CharT>() : slice<CharT>(m_pos, static_cast<usize>(m_last - m_pos));
+    }
+
+    /// lazily yields the remaining pieces for helix code, the generator keeps its own copy of the
+    /// splitter.
+    auto iter() const -> helix::$generator<slice<CharT>> { return generate(*this); }
+
+  private:
+    static auto generate(splitter self) -> helix::$generator<slice<CharT>> {
+        slice<CharT> piece;
+
+        while (self.next(piece)) {
+            co_yield piece;
+        }
+    }
+
+    Delimiter    m_delimiter;
+    const CharT *m_pos;
+    const CharT *m_last;
+    bool         m_done = false;
+    bool         m_skip = false;
+};
+
+/// \include belongs to the helix standard library.
+/// \brief lazily split `text` at every `delimiter` character.
+template <typename Text>
+    requires _split::Source<Text>
+auto split(Text &&text, _split::char_of<Text> delimiter) noexcept {
+    using CharT = _split::char_of<Text>;
+    return splitter<CharT, _split::Char<CharT>>(_split::view(text), {delimiter});
+}
+
+/// \include belongs to the helix standard library.
+/// \brief lazily split `text` at every occurrence of `delimiter`, which must not be empty.
+template <typename Text>
+    requires _split::Source<Text>
+auto split(Text &&text, slice<_split::char_of<Text>> delimiter) {
+    using CharT = _split::char_of<Text>;
+
+    if (delimiter.empty()) {
+        throw H_STD_NAMESPACE::errors::RuntimeError("empty split delimiter.");
+    }
+
+    return splitter<CharT, _split::Needle<CharT>>(_split::view(text), {delimiter});
+}
+
+template <typename Text, usize N>
+    requires _split::Source<Text>
+auto split(Text &&text, const _split::char_of<Text> (&delimiter)[N]) {
+    return split(LIBCXX_NAMESPACE::forward<Text>(text), slice<_split::char_of<Text>>(delimiter, _string::array_length(delimiter)));
+}
+
+/// \include belongs to the helix standard library.
+/// \brief lazily split `text` at every character for which `pred` holds.
+template <typename Text, typename Pred>
+    requires(_split::Source<Text> && LIBCXX_NAMESPACE::is_invocable_r_v<bool, Pred &, _split::char_of<Text>>)
+auto split(Text &&text, Pred pred) {
+    using CharT = _split::char_of<Text>;
+    return splitter<CharT, _split::Predicate<CharT, Pred>>(_split::view(text), {LIBCXX_NAMESPACE::move(pred)});
+}
+
+/// \include belongs to the helix standard library.
+/// \brief lazily split `text` at every character that is one of `set`, `split_any(line, ",;")`.
+template <typename Text>
+    requires _split::Source<Text>
+auto split_any(Text &&text, slice<_split::char_of<Text>> set) noexcept {
+    using CharT = _split::char_of<Text>;
+    return splitter<CharT, _split::AnyOf<CharT>>(_split::view(text), {set});
+}
+
+template <typename Text, usize N>
+    requires _split::Source<Text>
+auto split_any(Text &&text, const _split::char_of<Text> (&set)[N]) noexcept {
+    return split_any(LIBCXX_NAMESPACE::forward<Text>(text), slice<_split::char_of<Text>>(set, _string::array_length(set)));
+}
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
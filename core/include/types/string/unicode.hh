@@ -0,0 +1,812 @@
+///--- The Helix Project ------------------------------------------------------------------------///
+///                                                                                              ///
+///   Part of the Helix Project, under the Attribution 4.0 International license (CC BY 4.0).    ///
+///   You are allowed to use, modify, redistribute, and create derivative works, even for        ///
+///   commercial purposes, provided that you give appropriate credit, and indicate if changes    ///
+///   were made.                                                                                 ///
+///                                                                                              ///
+///   For more information on the license terms and requirements, please visit:                  ///
+///     https://creativecommons.org/licenses/by/4.0/                                             ///
+///                                                                                              ///
+///   SPDX-License-Identifier: CC-BY-4.0                                                         ///
+///   Copyright (c) 2024 The Helix Project (CC BY 4.0)                                           ///
+///                                                                                              ///
+///------------------------------------------------------------------------------------ Helix ---///
+
+#ifndef __$LIBHELIX_STRING_UNICODE__
+#define __$LIBHELIX_STRING_UNICODE__
+
+#include "../../config.h"
+#include "../../libcxx.h"
+#include "../../primitives.h"
+#include "../errors.h"
+#include "../string.hh"
+
+#ifdef H_SIMD_X86
+#include <immintrin.h>
+#endif
+
+H_NAMESPACE_BEGIN
+
+namespace String {
+namespace Unicode {
+    /// why a sequence was rejected, see `Result`.
+    enum class Error : u8 {
+        None,
+        Truncated,  ///< the input ends in the middle of a sequence
+        Invalid,    ///< a stray continuation byte, or a lead byte without its continuations
+        Overlong,   ///< a UTF-8 sequence longer than the code point needs
+        Surrogate,  ///< an encoded surrogate, or an unpaired UTF-16 surrogate
+        TooLarge,   ///< a code point above U+10FFFF
+    };
+
+    /// \struct Result
+    /// The outcome of validating or converting: `read` input units were consumed (on error, the
+    /// offset of the offending sequence) and `written` output units produced.
+    struct Result {
+        Error error   = Error::None;
+        usize read    = 0;
+        usize written = 0;
+
+        [[nodiscard]] constexpr bool ok() const noexcept { return error == Error::None; }
+    };
+
+    constexpr const char *describe(Error error) noexcept {
+        switch (error) {
+            case Error::None:
+                return "valid";
+            case Error::Truncated:
+                return "truncated sequence";
+            case Error::Invalid:
+                return "invalid sequence";
+            case Error::Overlong:
+                return "overlong sequence";
+            case Error::Surrogate:
+                return "unpaired or encoded surrogate";
+            default:
+                return "code point above U+10FFFF";
+        }
+    }
+}  // namespace Unicode
+
+namespace _unicode {
+    using Unicode::Error;
+    using Unicode::Result;
+
+    /// the encoding is chosen by size: one byte characters hold UTF-8, two UTF-16 and four UTF-32
+    /// (so `wchar_t` follows the platform).
+    template <typename CharT>
+    concept Unit = LIBCXX_NAMESPACE::is_integral_v<CharT> && (sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+    template <typename Text>
+    concept Encoded = requires(const Text &text) {
+        { text.size() } -> std::Meta::convertible_to<usize>;
+        requires Unit<LIBCXX_NAMESPACE::remove_cvref_t<decltype(*text.data())>>;
+    };
+
+    template <typename Text>
+    using unit_of = LIBCXX_NAMESPACE::remove_cvref_t<decltype(*LIBCXX_NAMESPACE::declval<const Text &>().data())>;
+
+    template <typename CharT>
+    constexpr u32 value(CharT unit) noexcept {
+        return static_cast<u32>(static_cast<LIBCXX_NAMESPACE::make_unsigned_t<CharT>>(unit));
+    }
+
+    struct Step {
+        char32_t point;
+        usize    length;
+        Error    error;
+    };
+
+    /// decode the code point starting at `src` (before `last`) and report how many units it took.
+    template <typename CharT>
+    constexpr Step read(const CharT *src, const CharT *last) noexcept {
+        const u32 lead = value(src[0]);
+
+        if constexpr (sizeof(CharT) == 1) {
+            if (lead < 0x80) {
+                return {lead, 1, Error::None};
+            }
+
+            if (lead < 0xC2) {
+                return {0, 1, lead < 0xC0 ? Error::Invalid : Error::Overlong};
+            }
+
+            if (lead > 0xF4) {
+                return {0, 1, Error::TooLarge};
+            }
+
+            // the second byte's range is narrower after E0, ED, F0 and F4
+            const usize length = lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+            const u32   low    = lead == 0xE0 ? 0xA0 : lead == 0xF0 ? 0x90 : 0x80;
+            const u32   high   = lead == 0xED ? 0x9F : lead == 0xF4 ? 0x8F : 0xBF;
+
+            u32 point = lead & (0x7F >> length);
+
+            for (usize i = 1; i < length; ++i) {
+                if (src + i == last) {
+                    return {0, i, Error::Truncated};
+                }
+
+                const u32 byte = value(src[i]);
+
+                if ((byte & 0xC0) != 0x80) {
+                    return {0, i, Error::Invalid};
+                }
+
+                if (i == 1 && (byte < low || byte > high)) {
+                    return {0, i, low != 0x80 ? Error::Overlong : lead == 0xED ? Error::Surrogate : Error::TooLarge};
+                }
+
+                point = (point << 6) | (byte & 0x3F);
+            }
+
+            return {point, length, Error::None};
+        } else if constexpr (sizeof(CharT) == 2) {
+            if ((lead & 0xF800) != 0xD800) {
+                return {lead, 1, Error::None};
+            }
+
+            if (lead >= 0xDC00) {
+                return {0, 1, Error::Surrogate};
+            }
+
+            if (src + 1 == last) {
+                return {0, 1, Error::Truncated};
+            }
+
+            const u32 trail = value(src[1]);
+
+            if ((trail & 0xFC00) != 0xDC00) {
+                return {0, 1, Error::Surrogate};
+            }
+
+            return {0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00), 2, Error::None};
+        } else {
+            if (lead > 0x10FFFF) {
+                return {0, 1, Error::TooLarge};
+            }
+
+            return {lead, 1, (lead & 0xFFFFF800) == 0xD800 ? Error::Surrogate : Error::None};
+        }
+    }
+
+    /// encode a valid code point at `dst`, returns the number of units written.
+    template <typename CharT>
+    constexpr usize write(char32_t point, CharT *dst) noexcept {
+        if constexpr (sizeof(CharT) == 1) {
+            if (point < 0x80) {
+                dst[0] = static_cast<CharT>(point);
+                return 1;
+            }
+
+            if (point < 0x800) {
+                dst[0] = static_cast<CharT>(0xC0 | (point >> 6));
+                dst[1] = static_cast<CharT>(0x80 | (point & 0x3F));
+                return 2;
+            }
+
+            if (point < 0x10000) {
+                dst[0] = static_cast<CharT>(0xE0 | (point >> 12));
+                dst[1] = static_cast<CharT>(0x80 | ((point >> 6) & 0x3F));
+                dst[2] = static_cast<CharT>(0x80 | (point & 0x3F));
+                return 3;
+            }
+
+            dst[0] = static_cast<CharT>(0xF0 | (point >> 18));
+            dst[1] = static_cast<CharT>(0x80 | ((point >> 12) & 0x3F));
+            dst[2] = static_cast<CharT>(0x80 | ((point >> 6) & 0x3F));
+            dst[3] = static_cast<CharT>(0x80 | (point & 0x3F));
+            return 4;
+        } else if constexpr (sizeof(CharT) == 2) {
+            if (point < 0x10000) {
+                dst[0] = static_cast<CharT>(point);
+                return 1;
+            }
+
+            dst[0] = static_cast<CharT>(0xD800 + ((point - 0x10000) >> 10));
+            dst[1] = static_cast<CharT>(0xDC00 + ((point - 0x10000) & 0x3FF));
+            return 2;
+        } else {
+            dst[0] = static_cast<CharT>(point);
+            return 1;
+        }
+    }
+
+    namespace scalar {
+        template <typename CharT>
+        constexpr Result validate(const CharT *first, const CharT *last) noexcept {
+            const CharT *src = first;
+
+            while (src != last) {
+                if constexpr (sizeof(CharT) == 1) {
+                    if (value(*src) < 0x80) {
+                        ++src;
+                        continue;
+                    }
+                }
+
+                const Step step = read(src, last);
+
+                if (step.error != Error::None) {
+                    return {step.error, static_cast<usize>(src - first), 0};
+                }
+
+                src += step.length;
+            }
+
+            return {Error::None, static_cast<usize>(last - first), 0};
+        }
+
+        template <typename From, typename To>
+        constexpr Result convert(const From *first, const From *last, To *out) noexcept {
+            const From *src = first;
+            To         *dst = out;
+
+            while (src != last) {
+                const Step step = read(src, last);
+
+                if (step.error != Error::None) {
+                    return {step.error, static_cast<usize>(src - first), static_cast<usize>(dst - out)};
+                }
+
+                dst += write(step.point, dst);
+                src += step.length;
+            }
+
+            return {Error::None, static_cast<usize>(last - first), static_cast<usize>(dst - out)};
+        }
+
+        /// output units needed for `[first, last)`, exact for valid input and never an
+        /// underestimate of what `convert` writes before stopping at an error. branch free, so the
+        /// compiler vectorizes the UTF-16 and UTF-32 cases; UTF-8 input has explicit kernels.
+        template <typename To, typename From>
+        constexpr usize length(const From *first, const From *last) noexcept {
+            usize count = 0;
+
+            for (; first != last; ++first) {
+                const u32 unit = value(*first);
+
+                if constexpr (sizeof(From) == 1) {
+                    count += static_cast<usize>((unit & 0xC0) != 0x80);
+                    count += static_cast<usize>(sizeof(To) == 2 && unit >= 0xF0);
+                } else if constexpr (sizeof(From) == 2 && sizeof(To) == 1) {
+                    count += 1 + static_cast<usize>(unit >= 0x80) + static_cast<usize>(unit >= 0x800) -
+                             static_cast<usize>((unit & 0xF800) == 0xD800);
+                } else if constexpr (sizeof(From) == 2) {
+                    count += static_cast<usize>((unit & 0xFC00) != 0xDC00);
+                } else if constexpr (sizeof(To) == 1) {
+                    count += 1 + static_cast<usize>(unit >= 0x80) + static_cast<usize>(unit >= 0x800) +
+                             static_cast<usize>(unit >= 0x10000);
+                } else {
+                    count += 1 + static_cast<usize>(sizeof(To) == 2 && unit >= 0x10000);
+                }
+            }
+
+            return count;
+        }
+    }  // namespace scalar
+
+#ifdef H_SIMD_X86
+    /// the lookup tables of the vector UTF-8 validator (Keiser and Lemire, "Validating UTF-8 In
+    /// Less Than One Instruction Per Byte"). every error is a pattern in the high nibble of a
+    /// byte and the two nibbles of the byte before it; each table maps one nibble to the set of
+    /// errors it allows, a pair is wrong when all three agree.
+    namespace utf8_tables {
+        inline constexpr u8 too_short  = 1 << 0;  // 11______ 0_______ or 11______ 11______
+        inline constexpr u8 too_long   = 1 << 1;  // 0_______ 10______
+        inline constexpr u8 overlong_3 = 1 << 2;  // 11100000 100_____
+        inline constexpr u8 too_large  = 1 << 3;  // 11110100 1001____ or 11110100 101_____
+        inline constexpr u8 surrogate  = 1 << 4;  // 11101101 101_____
+        inline constexpr u8 overlong_2 = 1 << 5;  // 1100000_ 10______
+        inline constexpr u8 large_1000 = 1 << 6;  // 11110101+ 1000____
+        inline constexpr u8 overlong_4 = 1 << 6;  // 11110000 1000____
+        inline constexpr u8 two_conts  = 1 << 7;  // 10______ 10______, unless a 3rd or 4th byte
+        inline constexpr u8 carry      = too_short | too_long | two_conts;
+
+        inline constexpr u8 byte_1_high[16] = {
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,  // ascii
+            two_conts, two_conts, two_conts, two_conts,                                      // continuation
+            too_short | overlong_2,                                                          // 1100
+            too_short,                                                                       // 1101
+            too_short | overlong_3 | surrogate,                                              // 1110
+            too_short | too_large | large_1000 | overlong_4,                                 // 1111
+        };
+
+        inline constexpr u8 byte_1_low[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,             // ____0000
+            carry | overlong_2,                                       // ____0001
+            carry,                                                    // ____0010
+            carry,                                                    // ____0011
+            carry | too_large,                                        // ____0100
+            carry | too_large | large_1000,                           // ____0101
+            carry | too_large | large_1000,                           // ____0110
+            carry | too_large | large_1000,                           // ____0111
+            carry | too_large | large_1000,                           // ____1000
+            carry | too_large | large_1000,                           // ____1001
+            carry | too_large | large_1000,                           // ____1010
+            carry | too_large | large_1000,                           // ____1011
+            carry | too_large | large_1000,                           // ____1100
+            carry | too_large | large_1000 | surrogate,               // ____1101
+            carry | too_large | large_1000,                           // ____1110
+            carry | too_large | large_1000,                           // ____1111
+        };
+
+        inline constexpr u8 byte_2_high[16] = {
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,  // ascii
+            too_long | overlong_2 | two_conts | overlong_3 | large_1000 | overlong_4,                  // 1000
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,                                // 1001
+            too_long | overlong_2 | two_conts | surrogate | too_large,                                 // 1010
+            too_long | overlong_2 | two_conts | surrogate | too_large,                                 // 1011
+            too_short, too_short, too_short, too_short,                                                // lead
+        };
+    }  // namespace utf8_tables
+
+    /// as in `search.hh`, the kernels are written once (`unicode.inc`) and included per
+    /// instruction set; `Lanes` holds the intrinsics that differ. the UTF-8 validator needs a
+    /// byte shuffle, so the 16 byte set is SSSE3 rather than plain SSE2.
+    namespace ssse3 {
+        struct Lanes {
+            using reg = __m128i;
+
+            static constexpr usize width = 16;
+
+            H_TARGET("ssse3") static reg load(const void *ptr) { return _mm_loadu_si128(static_cast<const __m128i *>(ptr)); }
+            H_TARGET("ssse3") static void store(void *ptr, reg value) { _mm_storeu_si128(static_cast<__m128i *>(ptr), value); }
+            H_TARGET("ssse3") static reg  zero() { return _mm_setzero_si128(); }
+            H_TARGET("ssse3") static reg  splat(u8 byte) { return _mm_set1_epi8(static_cast<char>(byte)); }
+            H_TARGET("ssse3") static reg  table(const u8 (&bytes)[16]) { return load(bytes); }
+            H_TARGET("ssse3") static reg  either(reg lhs, reg rhs) { return _mm_or_si128(lhs, rhs); }
+            H_TARGET("ssse3") static reg  both(reg lhs, reg rhs) { return _mm_and_si128(lhs, rhs); }
+            H_TARGET("ssse3") static reg  differ(reg lhs, reg rhs) { return _mm_xor_si128(lhs, rhs); }
+            H_TARGET("ssse3") static reg  lookup(reg table, reg index) { return _mm_shuffle_epi8(table, index); }
+            H_TARGET("ssse3") static reg  high_nibble(reg value) { return both(_mm_srli_epi16(value, 4), splat(0x0F)); }
+            H_TARGET("ssse3") static reg  subs(reg value, reg amount) { return _mm_subs_epu8(value, amount); }
+            H_TARGET("ssse3") static reg  greater(reg lhs, reg rhs) { return _mm_cmpgt_epi8(lhs, rhs); }
+            H_TARGET("ssse3") static reg  equal(reg lhs, reg rhs) { return _mm_cmpeq_epi8(lhs, rhs); }
+            H_TARGET("ssse3") static reg  sub(reg lhs, reg rhs) { return _mm_sub_epi8(lhs, rhs); }
+            H_TARGET("ssse3") static u32  mask(reg value) { return static_cast<u32>(_mm_movemask_epi8(value)); }
+            H_TARGET("ssse3") static bool ascii(reg value) { return _mm_movemask_epi8(value) == 0; }
+            H_TARGET("ssse3") static bool any(reg value) {
+                return _mm_movemask_epi8(_mm_cmpeq_epi8(value, _mm_setzero_si128())) != 0xFFFF;
+            }
+            H_TARGET("ssse3") static usize sum(reg counts) {
+                const __m128i sums = _mm_sad_epu8(counts, _mm_setzero_si128());
+                return static_cast<usize>(_mm_cvtsi128_si64(sums)) +
+                       static_cast<usize>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sums, sums)));
+            }
+
+            /// the bytes `N` positions back: the tail of `prev` followed by the head of `input`.
+            template <int N>
+            H_TARGET("ssse3") static reg prev(reg input, reg prev) {
+                return _mm_alignr_epi8(input, prev, 16 - N);
+            }
+
+            /// zero extend a block of bytes to `width` 16 or 32 bit units at `dst`.
+            H_TARGET("ssse3") static void widen16(reg bytes, void *dst) {
+                store(dst, _mm_unpacklo_epi8(bytes, zero()));
+                store(static_cast<char *>(dst) + 16, _mm_unpackhi_epi8(bytes, zero()));
+            }
+
+            H_TARGET("ssse3") static void widen32(reg bytes, void *dst) {
+                const reg low  = _mm_unpacklo_epi8(bytes, zero());
+                const reg high = _mm_unpackhi_epi8(bytes, zero());
+                auto     *out  = static_cast<char *>(dst);
+
+                store(out, _mm_unpacklo_epi16(low, zero()));
+                store(out + 16, _mm_unpackhi_epi16(low, zero()));
+                store(out + 32, _mm_unpacklo_epi16(high, zero()));
+                store(out + 48, _mm_unpackhi_epi16(high, zero()));
+            }
+
+            // block conversions, each returns false (writing nothing) unless every unit of the
+            // block takes the fast path. a block is `width` bytes of input.
+
+            H_TARGET("ssse3") static bool ascii16_to8(const void *src, void *dst) {
+                const reg units = load(src);
+
+                if (any(both(units, _mm_set1_epi16(static_cast<short>(0xFF80))))) {
+                    return false;
+                }
+
+                _mm_storel_epi64(static_cast<__m128i *>(dst), _mm_packus_epi16(units, units));
+                return true;
+            }
+
+            H_TARGET("ssse3") static bool ascii32_to8(const void *src, void *dst) {
+                const reg units = load(src);
+
+                if (any(both(units, _mm_set1_epi32(static_cast<int>(0xFFFFFF80))))) {
+                    return false;
+                }
+
+                const reg packed = _mm_packus_epi16(_mm_packs_epi32(units, units), zero());
+                const int bytes  = _mm_cvtsi128_si32(packed);
+                LIBCXX_NAMESPACE::memcpy(dst, &bytes, 4);
+                return true;
+            }
+
+            H_TARGET("ssse3") static bool bmp16_to32(const void *src, void *dst) {
+                const reg units = load(src);
+                const reg high  = both(units, _mm_set1_epi16(static_cast<short>(0xF800)));
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_set1_epi16(static_cast<short>(0xD800)))) != 0) {
+                    return false;
+                }
+
+                store(dst, _mm_unpacklo_epi16(units, zero()));
+                store(static_cast<char *>(dst) + 16, _mm_unpackhi_epi16(units, zero()));
+                return true;
+            }
+
+            /// units below U+D800 are narrowed with a signed pack, shifted into range and back.
+            H_TARGET("ssse3") static bool bmp32_to16(const void *src, void *dst) {
+                const reg units = load(src);
+
+                const reg sign = _mm_set1_epi32(static_cast<int>(0x80000000));  // unsigned compare
+
+                if (_mm_movemask_epi8(_mm_cmpgt_epi32(_mm_set1_epi32(static_cast<int>(0x8000D800)), _mm_xor_si128(units, sign))) != 0xFFFF) {
+                    return false;
+                }
+
+                const reg bias   = _mm_set1_epi32(0x8000);
+                const reg packed = _mm_packs_epi32(_mm_sub_epi32(units, bias), zero());
+                _mm_storel_epi64(static_cast<__m128i *>(dst), _mm_add_epi16(packed, _mm_set1_epi16(static_cast<short>(0x8000))));
+                return true;
+            }
+
+            /// no surrogates at all, every unit is a code point of its own.
+            H_TARGET("ssse3") static bool plain16(const void *src) {
+                const reg high = both(load(src), _mm_set1_epi16(static_cast<short>(0xF800)));
+                return _mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_set1_epi16(static_cast<short>(0xD800)))) == 0;
+            }
+
+            /// every unit is a scalar value: not a surrogate and at most U+10FFFF.
+            H_TARGET("ssse3") static bool plain32(const void *src) {
+                const reg units     = load(src);
+                const reg surrogate = _mm_cmpeq_epi32(both(units, _mm_set1_epi32(static_cast<int>(0xFFFFF800))), _mm_set1_epi32(0xD800));
+                const reg large     = _mm_cmpgt_epi32(_mm_sub_epi32(units, _mm_set1_epi32(static_cast<int>(0x80000000))),
+                                                      _mm_set1_epi32(static_cast<int>(0x8010FFFF)));
+                return !any(either(surrogate, large));
+            }
+        };
+    }  // namespace ssse3
+
+    namespace avx2 {
+        struct Lanes {
+            using reg = __m256i;
+
+            static constexpr usize width = 32;
+
+            H_TARGET("avx2") static reg load(const void *ptr) { return _mm256_loadu_si256(static_cast<const __m256i *>(ptr)); }
+            H_TARGET("avx2") static void store(void *ptr, reg value) { _mm256_storeu_si256(static_cast<__m256i *>(ptr), value); }
+            H_TARGET("avx2") static reg  zero() { return _mm256_setzero_si256(); }
+            H_TARGET("avx2") static reg  splat(u8 byte) { return _mm256_set1_epi8(static_cast<char>(byte)); }
+            H_TARGET("avx2") static reg  table(const u8 (&bytes)[16]) {
+                return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes)));
+            }
+            H_TARGET("avx2") static reg  either(reg lhs, reg rhs) { return _mm256_or_si256(lhs, rhs); }
+            H_TARGET("avx2") static reg  both(reg lhs, reg rhs) { return _mm256_and_si256(lhs, rhs); }
+            H_TARGET("avx2") static reg  differ(reg lhs, reg rhs) { return _mm256_xor_si256(lhs, rhs); }
+            H_TARGET("avx2") static reg  lookup(reg table, reg index) { return _mm256_shuffle_epi8(table, index); }
+            H_TARGET("avx2") static reg  high_nibble(reg value) { return both(_mm256_srli_epi16(value, 4), splat(0x0F)); }
+            H_TARGET("avx2") static reg  subs(reg value, reg amount) { return _mm256_subs_epu8(value, amount); }
+            H_TARGET("avx2") static reg  greater(reg lhs, reg rhs) { return _mm256_cmpgt_epi8(lhs, rhs); }
+            H_TARGET("avx2") static reg  equal(reg lhs, reg rhs) { return _mm256_cmpeq_epi8(lhs, rhs); }
+            H_TARGET("avx2") static reg  sub(reg lhs, reg rhs) { return _mm256_sub_epi8(lhs, rhs); }
+            H_TARGET("avx2") static u32  mask(reg value) { return static_cast<u32>(_mm256_movemask_epi8(value)); }
+            H_TARGET("avx2") static bool ascii(reg value) { return _mm256_movemask_epi8(value) == 0; }
+            H_TARGET("avx2") static bool any(reg value) { return _mm256_testz_si256(value, value) == 0; }
+            H_TARGET("avx2") static usize sum(reg counts) {
+                const __m256i sums = _mm256_sad_epu8(counts, _mm256_setzero_si256());
+                return static_cast<usize>(_mm256_extract_epi64(sums, 0)) + static_cast<usize>(_mm256_extract_epi64(sums, 1)) +
+                       static_cast<usize>(_mm256_extract_epi64(sums, 2)) + static_cast<usize>(_mm256_extract_epi64(sums, 3));
+            }
+
+            /// `alignr` works per 128 bit lane, so the lane below `input`'s is assembled first.
+            template <int N>
+            H_TARGET("avx2") static reg prev(reg input, reg prev) {
+                return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+            }
+
+            H_TARGET("avx2") static void widen16(reg bytes, void *dst) {
+                store(dst, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes)));
+                store(static_cast<char *>(dst) + 32, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1)));
+            }
+
+            H_TARGET("avx2") static void widen32(reg bytes, void *dst) {
+                const __m128i low  = _mm256_castsi256_si128(bytes);
+                const __m128i high = _mm256_extracti128_si256(bytes, 1);
+                auto         *out  = static_cast<char *>(dst);
+
+                store(out, _mm256_cvtepu8_epi32(low));
+                store(out + 32, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+                store(out + 64, _mm256_cvtepu8_epi32(high));
+                store(out + 96, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+            }
+
+            H_TARGET("avx2") static bool ascii16_to8(const void *src, void *dst) {
+                const reg units = load(src);
+
+                if (any(both(units, _mm256_set1_epi16(static_cast<short>(0xFF80))))) {
+                    return false;
+                }
+
+                _mm_storeu_si128(static_cast<__m128i *>(dst),
+                                 _mm_packus_epi16(_mm256_castsi256_si128(units), _mm256_extracti128_si256(units, 1)));
+                return true;
+            }
+
+            H_TARGET("avx2") static bool ascii32_to8(const void *src, void *dst) {
+                const reg units = load(src);
+
+                if (any(both(units, _mm256_set1_epi32(static_cast<int>(0xFFFFFF80))))) {
+                    return false;
+                }
+
+                const __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(units), _mm256_extracti128_si256(units, 1));
+                _mm_storel_epi64(static_cast<__m128i *>(dst), _mm_packus_epi16(words, words));
+                return true;
+            }
+
+            H_TARGET("avx2") static bool bmp16_to32(const void *src, void *dst) {
+                const reg units = load(src);
+                const reg high  = both(units, _mm256_set1_epi16(static_cast<short>(0xF800)));
+
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi16(high, _mm256_set1_epi16(static_cast<short>(0xD800)))) != 0) {
+                    return false;
+                }
+
+                store(dst, _mm256_cvtepu16_epi32(_mm256_castsi256_si128(units)));
+                store(static_cast<char *>(dst) + 32, _mm256_cvtepu16_epi32(_mm256_extracti128_si256(units, 1)));
+                return true;
+            }
+
+            H_TARGET("avx2") static bool bmp32_to16(const void *src, void *dst) {
+                const reg units = load(src);
+
+                const reg sign = _mm256_set1_epi32(static_cast<int>(0x80000000));
+
+                if (static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(0x8000D800)),
+                                                                             _mm256_xor_si256(units, sign)))) != 0xFFFFFFFFU) {
+                    return false;
+                }
+
+                const reg     biased = _mm256_sub_epi32(units, _mm256_set1_epi32(0x8000));
+                const __m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(biased), _mm256_extracti128_si256(biased, 1));
+                _mm_storeu_si128(static_cast<__m128i *>(dst), _mm_add_epi16(packed, _mm_set1_epi16(static_cast<short>(0x8000))));
+                return true;
+            }
+
+            H_TARGET("avx2") static bool plain16(const void *src) {
+                const reg high = both(load(src), _mm256_set1_epi16(static_cast<short>(0xF800)));
+                return _mm256_movemask_epi8(_mm256_cmpeq_epi16(high, _mm256_set1_epi16(static_cast<short>(0xD800)))) == 0;
+            }
+
+            H_TARGET("avx2") static bool plain32(const void *src) {
+                const reg units     = load(src);
+                const reg surrogate = _mm256_cmpeq_epi32(both(units, _mm256_set1_epi32(static_cast<int>(0xFFFFF800))),
+                                                         _mm256_set1_epi32(0xD800));
+                const reg large     = _mm256_cmpgt_epi32(_mm256_sub_epi32(units, _mm256_set1_epi32(static_cast<int>(0x80000000))),
+                                                         _mm256_set1_epi32(static_cast<int>(0x8010FFFF)));
+                return !any(either(surrogate, large));
+            }
+        };
+    }  // namespace avx2
+
+    namespace ssse3 {
+#define H_KERNEL_TARGET H_TARGET("ssse3")
+#include "unicode.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace ssse3
+
+    namespace avx2 {
+#define H_KERNEL_TARGET H_TARGET("avx2")
+#include "unicode.inc"
+#undef H_KERNEL_TARGET
+    }  // namespace avx2
+#endif
+
+    enum class Level : u8 { Scalar, SSSE3, AVX2 };
+
+    inline Level detect() noexcept {
+#ifdef H_SIMD_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2")) {
+            return Level::AVX2;
+        }
+
+        if (__builtin_cpu_supports("ssse3")) {
+            return Level::SSSE3;
+        }
+#endif
+        return Level::Scalar;
+    }
+
+    /// the kernels are templates over the character types, so instead of a table of function
+    /// pointers (as in `search.hh`) the detected level is cached and switched on.
+    inline Level level() noexcept {
+        static const Level cached = detect();
+        return cached;
+    }
+
+    template <typename CharT>
+    Result validate(const CharT *first, const CharT *last) noexcept {
+        if constexpr (sizeof(CharT) == 1) {
+            const CharT *bad = last;
+
+#ifdef H_SIMD_X86
+            switch (level()) {
+                case Level::AVX2:
+                    bad = avx2::invalid_utf8(first, last);
+                    break;
+                case Level::SSSE3:
+                    bad = ssse3::invalid_utf8(first, last);
+                    break;
+                default:
+                    return scalar::validate(first, last);
+            }
+#else
+            return scalar::validate(first, last);
+#endif
+
+            if (bad == last) {
+                return {Error::None, static_cast<usize>(last - first), 0};
+            }
+
+            // the kernel reports the group where it noticed, a sequence cut off at the end of the
+            // group before belongs to it: restart at that sequence's lead byte, if any
+            for (usize back = 1; back <= 4 && back <= static_cast<usize>(bad - first); ++back) {
+                const u32 unit = value(bad[-static_cast<isize>(back)]);
+
+                if ((unit & 0xC0) != 0x80) {
+                    bad -= unit >= 0xC0 ? back : 0;
+                    break;
+                }
+            }
+
+            Result result = scalar::validate(bad, last);
+            result.read += static_cast<usize>(bad - first);
+
+            return result;
+        } else {
+#ifdef H_SIMD_X86
+            switch (level()) {
+                case Level::AVX2:
+                    return avx2::validate(first, last);
+                case Level::SSSE3:
+                    return ssse3::validate(first, last);
+                default:
+                    break;
+            }
+#endif
+            return scalar::validate(first, last);
+        }
+    }
+
+    template <typename To, typename From>
+    usize length(const From *first, const From *last) noexcept {
+        if constexpr (sizeof(From) == sizeof(To)) {
+            return static_cast<usize>(last - first);
+        } else {
+#ifdef H_SIMD_X86
+            if constexpr (sizeof(From) == 1) {
+                switch (level()) {
+                    case Level::AVX2:
+                        return avx2::utf8_length<To>(first, last);
+                    case Level::SSSE3:
+                        return ssse3::utf8_length<To>(first, last);
+                    default:
+                        break;
+                }
+            }
+#endif
+            return scalar::length<To>(first, last);
+        }
+    }
+
+    template <typename From, typename To>
+    Result convert(const From *first, const From *last, To *out) noexcept {
+        if constexpr (sizeof(From) == sizeof(To)) {
+            Result result = validate(first, last);
+
+            if (result.read != 0) {
+                LIBCXX_NAMESPACE::memcpy(out, first, result.read * sizeof(From));
+            }
+
+            result.written = result.read;
+            return result;
+        } else {
+#ifdef H_SIMD_X86
+            switch (level()) {
+                case Level::AVX2:
+                    return avx2::convert(first, last, out);
+                case Level::SSSE3:
+                    return ssse3::convert(first, last, out);
+                default:
+                    break;
+            }
+#endif
+            return scalar::convert(first, last, out);
+        }
+    }
+}  // namespace _unicode
+
+namespace Unicode {
+    /// \include belongs to the helix standard library.
+    /// \brief check that `text` is well formed UTF-8, UTF-16 or UTF-32 (picked by the size of its
+    /// character type).
+    ///
+    /// on failure `read` is the offset of the first bad sequence. runs on the vector kernels when
+    /// the CPU has them: a lookup table validator for UTF-8 (Keiser and Lemire), a block check for
+    /// surrogates and out of range values otherwise.
+    template <typename Text>
+        requires _unicode::Encoded<Text>
+    Result validate(const Text &text) noexcept {
+        return _unicode::validate(text.data(), text.data() + text.size());
+    }
+
+    template <typename Text>
+        requires _unicode::Encoded<Text>
+    bool valid(const Text &text) noexcept {
+        return validate(text).ok();
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief the number of `To` units `text` becomes once converted.
+    ///
+    /// exact for valid input, for invalid input it still bounds what `convert` writes before it
+    /// stops, so it is always safe for sizing the destination.
+    template <typename To, typename Text>
+        requires(_unicode::Encoded<Text> && _unicode::Unit<To>)
+    usize length(const Text &text) noexcept {
+        return _unicode::length<To>(text.data(), text.data() + text.size());
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief convert `text` into `dest`, which must hold `length<To>(text)` units.
+    ///
+    /// validates while converting and stops at the first bad sequence. blocks of plain ASCII (or
+    /// of BMP code points between UTF-16 and UTF-32) are converted a vector at a time.
+    template <typename To, typename Text>
+        requires(_unicode::Encoded<Text> && _unicode::Unit<To>)
+    Result convert(const Text &text, To *dest) noexcept {
+        return _unicode::convert(text.data(), text.data() + text.size(), dest);
+    }
+
+    /// \include belongs to the helix standard library.
+    /// \brief `text` converted to a new string of `To`.
+    ///
+    /// the output is sized first (`length`), so the result is allocated once at its exact size
+    /// and written once. throws `RuntimeError` on malformed input.
+    ///
+    /// ```cpp
+    /// auto wide = String::Unicode::transcode<char32_t>(String::slice<char>(bytes, size));
+    /// ```
+    template <typename To, usize _SlabSize = 16, typename Text>
+        requires(_unicode::Encoded<Text> && _unicode::Unit<To>)
+    basic<To, _SlabSize> transcode(const Text &text) {
+        const auto *first = text.data();
+        const auto *last  = first + text.size();
+
+        basic<To, _SlabSize> result;
+        Result               status;
+
+        result.resize_and_overwrite(_unicode::length<To>(first, last), [&](To *dest, usize) {
+            status = _unicode::convert(first, last, dest);
+            return status.written;
+        });
+
+        if (!status.ok()) {
+            throw H_STD_NAMESPACE::errors::RuntimeError(H_NAMESPACE::string("malformed unicode, ") + describe(status.error) + ".");
+        }
+
+        return result;
+    }
+}  // namespace Unicode
+}  // namespace String
+
+H_NAMESPACE_END
+
+#endif
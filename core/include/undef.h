@@ -24,5 +24,7 @@
 #undef H_NAMESPACE
 #undef LIBCXX_NAMESPACE
 #undef LIBC_NAMESPACE
+#undef H_SIMD_X86
+#undef H_TARGET
 
 #endif
\ No newline at end of file